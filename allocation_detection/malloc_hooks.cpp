@@ -0,0 +1,140 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/allocation_detection/malloc_hooks.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Interposes malloc() and related functions in order to report heap allocations
+ * to tAllocationCounter (see internal/tAllocationCounter.h).
+ *
+ * This file constitutes the opt-in 'allocation_detection' library.
+ * It replaces the allocation functions of the whole process - so it should only be
+ * linked to applications that are to be checked for allocations, or be loaded with
+ * LD_PRELOAD=libfinroc_plugins_structure_allocation_detection.so
+ * Allocations are forwarded to the glibc implementation; free() is not interposed.
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cerrno>
+#include <cstddef>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tAllocationCounter.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using finroc::structure::internal::tAllocationCounter;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+#ifdef __GLIBC__
+
+extern "C"
+{
+
+// glibc implementations of allocation functions
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size)
+{
+  tAllocationCounter::OnAllocation();
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+  tAllocationCounter::OnAllocation();
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+  tAllocationCounter::OnAllocation();
+  return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+  tAllocationCounter::OnAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+  tAllocationCounter::OnAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size)
+{
+  tAllocationCounter::OnAllocation();
+  if (alignment == 0 || (alignment & (alignment - 1)) || alignment % sizeof(void*))
+  {
+    return EINVAL;
+  }
+  void* memory = __libc_memalign(alignment, size);
+  if (!memory)
+  {
+    return ENOMEM;
+  }
+  *result = memory;
+  return 0;
+}
+
+}
+
+namespace
+{
+
+/*! Tells tAllocationCounter that allocations are reported */
+struct tHookRegistration
+{
+  tHookRegistration()
+  {
+    tAllocationCounter::SetHooksInstalled();
+  }
+} hook_registration;
+
+}
+
+#else
+#warning "Allocation detection hooks are only available with glibc"
+#endif
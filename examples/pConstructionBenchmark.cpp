@@ -0,0 +1,131 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/examples/pConstructionBenchmark.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \b pConstructionBenchmark
+ *
+ * Measures how construction, initialization and deletion of components
+ * scale with the number of components that exist at the same time.
+ *
+ * Usage: construction_benchmark [component count]...
+ * (default counts: 100 1000 10000 50000)
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include "core/tRuntimeEnvironment.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/examples/mTestModule.h"
+#include "plugins/structure/internal/register.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cDEFAULT_COMPONENT_COUNTS[] = { 100, 1000, 10000, 50000 };
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+static double MillisecondsSince(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+ * Constructs, initializes and deletes the specified number of test modules in one group
+ * and prints the time each step took
+ */
+static void RunBenchmark(size_t component_count)
+{
+  core::tFrameworkElement* group = new core::tFrameworkElement(&core::tRuntimeEnvironment::GetInstance(), "Benchmark " + std::to_string(component_count));
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < component_count; i++)
+  {
+    new structure::examples::mTestModule(group, "Module " + std::to_string(i));
+  }
+  double construction = MillisecondsSince(start);
+  size_t live_memory_blocks = structure::internal::GetRegisterStatistics().live_memory_blocks;
+
+  start = std::chrono::steady_clock::now();
+  group->Init();
+  double initialization = MillisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  group->ManagedDelete();
+  double deletion = MillisecondsSince(start);
+
+  FINROC_LOG_PRINT_STATIC(USER, "components: ", component_count, "  construct: ", construction, " ms (", construction * 1000000.0 / component_count, " ns per component, ",
+                          live_memory_blocks, " registered memory blocks)  init: ", initialization, " ms  delete: ", deletion, " ms");
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<size_t> component_counts;
+  for (int i = 1; i < argc; i++)
+  {
+    component_counts.push_back(std::strtoul(argv[i], NULL, 10));
+  }
+  if (component_counts.empty())
+  {
+    component_counts.assign(std::begin(cDEFAULT_COMPONENT_COUNTS), std::end(cDEFAULT_COMPONENT_COUNTS));
+  }
+
+  for (size_t component_count : component_counts)
+  {
+    if (component_count)
+    {
+      RunBenchmark(component_count);
+    }
+  }
+
+  core::tRuntimeEnvironment::Shutdown();
+  return 0;
+}
@@ -0,0 +1,195 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/background_worker.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/background_worker.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <ctime>
+#include "rrlib/logging/messages.h"
+#include "rrlib/thread/tThread.h"
+
+extern "C"
+{
+#include <pthread.h>
+#include <semaphore.h>
+}
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*! Jobs that were added and have not been taken yet (most recently added job first) */
+std::atomic<tBackgroundJob*> pending_jobs(nullptr);
+
+/*! Is worker thread running? (otherwise jobs are executed by the threads adding them) */
+std::atomic<bool> worker_active(false);
+
+/*! Posted whenever a job is added while worker thread is running (posting never blocks) */
+sem_t jobs_available;
+
+/*!
+ * Executes all pending jobs in the calling thread - in the order they were added
+ */
+void ExecutePendingJobs()
+{
+  tBackgroundJob* added_jobs = pending_jobs.exchange(nullptr);
+  tBackgroundJob* jobs = nullptr;
+  while (added_jobs)
+  {
+    tBackgroundJob* next = added_jobs->next;
+    added_jobs->next = jobs;
+    jobs = added_jobs;
+    added_jobs = next;
+  }
+
+  while (jobs)
+  {
+    tBackgroundJob* job = jobs;
+    jobs = job->next; // job might be added again as soon as it has been executed
+    try
+    {
+      job->Execute();
+    }
+    catch (const std::exception& e)
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Background job threw exception: ", e);
+    }
+  }
+}
+
+/*! Non-real-time worker thread */
+class tBackgroundWorkerThread : public rrlib::thread::tThread
+{
+public:
+
+  tBackgroundWorkerThread() : tThread("Background Worker")
+  {}
+
+  virtual void Run() override
+  {
+    // Threads inherit the scheduling policy of their creator - which might be a real-time thread
+    struct sched_param parameters;
+    parameters.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &parameters);
+
+    while (!IsStopSignalSet())
+    {
+      struct timespec timeout;
+      clock_gettime(CLOCK_REALTIME, &timeout);
+      timeout.tv_sec += 1; // check stop signal regularly
+      if (sem_timedwait(&jobs_available, &timeout) == 0)
+      {
+        ExecutePendingJobs();
+      }
+    }
+
+    // Jobs added from now on are executed by the threads adding them
+    worker_active.store(false);
+    ExecutePendingJobs();
+  }
+};
+
+}
+
+void StartBackgroundWorker()
+{
+  static bool started = []()
+  {
+    sem_init(&jobs_available, 0, 0);
+    worker_active.store(true);
+    tBackgroundWorkerThread* thread = new tBackgroundWorkerThread();
+    thread->SetAutoDelete();
+    thread->Start();
+    return true;
+  }();
+  (void)started;
+}
+
+void ExecuteInBackground(tBackgroundJob& job)
+{
+  tBackgroundJob* head = pending_jobs.load(std::memory_order_relaxed);
+  do
+  {
+    job.next = head;
+  }
+  while (!pending_jobs.compare_exchange_weak(head, &job));
+
+  if (worker_active.load())
+  {
+    sem_post(&jobs_available);
+  }
+  else
+  {
+    ExecutePendingJobs();
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,110 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/background_worker.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief
+ *
+ * Internal helper functions:
+ * Non-real-time worker thread that executes jobs taken off module tasks
+ * (e.g. asynchronous OnParametersChanged() calls)
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__background_worker_h__
+#define __plugins__structure__internal__background_worker_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Job for background worker
+/*!
+ * Jobs are provided by their owners (e.g. as member objects) -
+ * so that handing them over to the background worker does not allocate memory.
+ */
+class tBackgroundJob
+{
+public:
+
+  tBackgroundJob() : next(nullptr) {}
+
+  /*! Executes job (called by background worker thread) */
+  virtual void Execute() = 0;
+
+  /*! Next job in list of pending jobs (managed by background worker) */
+  tBackgroundJob* next;
+
+protected:
+
+  ~tBackgroundJob() {}
+};
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * Starts background worker thread (if it is not running yet).
+ * The thread runs with normal (non-real-time) scheduling - regardless of the calling thread's policy.
+ * (should be called during initialization - e.g. in PostChildInit())
+ */
+void StartBackgroundWorker();
+
+/*!
+ * Executes job in background worker thread.
+ * Does not block or allocate memory - so it may be called by real-time threads.
+ * If the worker thread is not running (not started yet or already stopped), the job is executed by the calling thread.
+ *
+ * \param job Job to execute (must not be passed again before its execution has started)
+ */
+void ExecuteInBackground(tBackgroundJob& job);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
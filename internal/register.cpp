@@ -32,6 +32,13 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <typeindex>
+#include <unordered_map>
 #include "rrlib/util/demangle.h"
 
 //----------------------------------------------------------------------
@@ -65,15 +72,58 @@ namespace internal
 // Const values
 //----------------------------------------------------------------------
 
+/*! Maximum number of memory blocks remembered per thread (oldest are dropped first) */
+static const size_t cTHREAD_LOCAL_BLOCK_COUNT = 16;
+
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
 
+/*!
+ * Memory blocks of instantiated modules - ordered by address (values are slot indices).
+ * As blocks do not overlap, the block containing an address is found with a single binary search
+ * (the last block starting at or before the address).
+ */
+typedef std::map<char*, uint32_t> tMemoryBlockMap;
+
+/*! Slot for a memory block in the register */
+struct tMemoryBlockSlot
+{
+  tInstantiatedModule block;
+
+  /*! Entry of this slot in address index */
+  tMemoryBlockMap::iterator index_entry;
+
+  /*! Incremented whenever slot is freed - so that outdated handles are detected (0 is never used) */
+  uint32_t generation;
+
+  /*! Is slot currently used? */
+  bool used;
+};
+
+/*! Port names of module types - by demangled RTTI name (without template arguments) */
+typedef std::unordered_map<std::string, tModulePorts> tModuleTypeMap;
+
+/*! Port names of module types that were registered with their RTTI type */
+typedef std::unordered_map<std::type_index, tModulePorts> tModuleRttiTypeMap;
+
+/*! Port names of module types - by RTTI type (filled on first lookup of a type and by registration with RTTI type) */
+typedef std::unordered_map<std::type_index, tModulePorts*> tModuleTypeCache;
+
 struct tStructureElementStorage
 {
   rrlib::thread::tMutex mutex;
-  std::vector<tInstantiatedModule> reg;
-  std::vector<tModulePorts> module_type_reg;
+
+  /*! Memory blocks are stored in slots - so that they can be removed in constant time using their handles */
+  std::vector<tMemoryBlockSlot> slots;
+  std::vector<uint32_t> free_slots;
+  tMemoryBlockMap reg;
+
+  /*! Separate mutex for port names - so that name lookups do not contend with the memory block register */
+  rrlib::thread::tMutex port_name_mutex;
+  tModuleTypeMap module_type_reg;
+  tModuleRttiTypeMap module_rtti_type_reg;
+  tModuleTypeCache module_type_cache;
 };
 static inline unsigned int GetLongevity(internal::tStructureElementStorage*)
 {
@@ -87,67 +137,418 @@ static rrlib::thread::tMutex& GetMutex()
   return tStructureElementStorageInstance::Instance().mutex;
 }
 
-static std::vector<tInstantiatedModule>& GetRegister()
+static tStructureElementStorage& GetStorage()
 {
-  return tStructureElementStorageInstance::Instance().reg;
+  return tStructureElementStorageInstance::Instance();
 }
 
-static std::vector<tModulePorts>& GetModuleTypeRegister()
+static rrlib::thread::tMutex& GetPortNameMutex()
+{
+  return tStructureElementStorageInstance::Instance().port_name_mutex;
+}
+
+static tModuleTypeMap& GetModuleTypeRegister()
 {
   return tStructureElementStorageInstance::Instance().module_type_reg;
 }
 
-void AddMemoryBlock(void* address, size_t size)
+static tModuleRttiTypeMap& GetModuleRttiTypeRegister()
 {
-  rrlib::thread::tLock lock(GetMutex());
-  FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Adding memory block at ", address, " with size ", size);
-  tInstantiatedModule m = {(char*)address, size, NULL };
-  GetRegister().push_back(m);
+  return tStructureElementStorageInstance::Instance().module_rtti_type_reg;
 }
 
-void AddModule(core::tFrameworkElement* module)
+static tModuleTypeCache& GetModuleTypeCache()
 {
-  rrlib::thread::tLock lock(GetMutex());
-  FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Adding module ", module, "...");
-  std::vector<tInstantiatedModule>& reg = GetRegister();
-  void* ptr = module;
-  for (int i = reg.size() - 1; i >= 0; i--) // reverse direction, because relevant module usually is at the end (the most recently added)
+  return tStructureElementStorageInstance::Instance().module_type_cache;
+}
+
+/*!
+ * Counters for register statistics (see tRegisterStatistics).
+ * They are only updated while statistics are enabled.
+ */
+static std::atomic<bool> statistics_enabled(false);
+static std::atomic<uint64_t> parent_lookups(0);
+static std::atomic<uint64_t> thread_local_hits(0);
+static std::atomic<uint64_t> scanned_blocks(0);
+static std::atomic<uint64_t> max_scan_length(0);
+static std::atomic<uint64_t> port_name_lookups(0);
+static std::atomic<uint64_t> port_name_type_resolutions(0);
+static std::atomic<uint64_t> mutex_wait_nanoseconds(0);
+static std::atomic<int64_t> statistics_start_nanoseconds(0);
+
+static int64_t SteadyClockNanoseconds()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*!
+ * Lock for register mutexes.
+ * Measures time spent waiting for the mutex if statistics are enabled.
+ */
+class tRegisterLock
+{
+public:
+  tRegisterLock(rrlib::thread::tMutex& mutex) :
+    wait_start(statistics_enabled.load(std::memory_order_relaxed) ? SteadyClockNanoseconds() : 0),
+    lock(mutex)
   {
-    if (ptr >= reg[i].address && ptr < reg[i].address + reg[i].size)
+    if (wait_start)
     {
-      assert(reg[i].module == NULL);
-      FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Module resides in memory block ", reg[i].address);
-      reg[i].module = module;
+      mutex_wait_nanoseconds.fetch_add(SteadyClockNanoseconds() - wait_start, std::memory_order_relaxed);
     }
   }
+
+private:
+  int64_t wait_start;
+  rrlib::thread::tLock lock;
+};
+
+/*!
+ * Records parent lookup in statistics
+ *
+ * \param scan_length Number of memory blocks that were checked
+ * \param thread_local_hit Was parent found in thread-local blocks?
+ */
+static void RecordParentLookup(uint64_t scan_length, bool thread_local_hit)
+{
+  if (statistics_enabled.load(std::memory_order_relaxed))
+  {
+    parent_lookups.fetch_add(1, std::memory_order_relaxed);
+    thread_local_hits.fetch_add(thread_local_hit ? 1 : 0, std::memory_order_relaxed);
+    scanned_blocks.fetch_add(scan_length, std::memory_order_relaxed);
+    uint64_t current_max = max_scan_length.load(std::memory_order_relaxed);
+    while (scan_length > current_max && (!max_scan_length.compare_exchange_weak(current_max, scan_length, std::memory_order_relaxed)))
+    {}
+  }
 }
 
-void RemoveModule(core::tFrameworkElement* module)
+/*! Entry in memory blocks of a thread */
+struct tThreadLocalBlock
 {
-  rrlib::thread::tLock lock(GetMutex());
-  FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Removing module ", module);
-  std::vector<tInstantiatedModule>& reg = GetRegister();
-  for (int i = reg.size() - 1; i >= 0; i--) // reverse direction, because relevant module is possibly rather at the end
+  tInstantiatedModule block;
+
+  /*! Handle of block in register */
+  tMemoryBlockHandle handle;
+};
+
+/*!
+ * Memory blocks of the components most recently allocated by a thread (most recent at the back).
+ *
+ * Components are constructed by the thread that allocated them.
+ * So, ports can look up their parent here - without acquiring the mutex.
+ * Only if this fails, the shared register is used.
+ */
+struct tThreadLocalBlocks
+{
+  std::array<tThreadLocalBlock, cTHREAD_LOCAL_BLOCK_COUNT> blocks;
+  size_t size;
+
+  /*! Value of module_removal_counter when blocks were last validated */
+  uint64_t removal_count;
+};
+static thread_local tThreadLocalBlocks thread_local_blocks;
+
+/*!
+ * Port construction batch that is currently open on a thread (see OpenPortConstructionBatch())
+ */
+struct tPortConstructionBatch
+{
+  /*! Component that batch was opened for (NULL if no batch is open) */
+  core::tFrameworkElement* component;
+
+  /*! Memory block of component */
+  char* address;
+  size_t size;
+
+  /*! Module type whose port names were last looked up for component - and its port names */
+  const std::type_info* type;
+  tModulePorts* module_ports;
+
+  /*! Value of module_removal_counter when batch was opened */
+  uint64_t removal_count;
+};
+static thread_local tPortConstructionBatch port_construction_batch;
+
+/*!
+ * Incremented whenever a module is removed.
+ * Memory of removed modules may be reused - so thread-local blocks are discarded when this counter changes.
+ */
+static std::atomic<uint64_t> module_removal_counter(0);
+
+/*!
+ * \return Memory blocks of current thread - with any possibly outdated blocks discarded
+ */
+static tThreadLocalBlocks& GetThreadLocalBlocks()
+{
+  uint64_t removal_count = module_removal_counter.load(std::memory_order_acquire);
+  if (thread_local_blocks.removal_count != removal_count)
+  {
+    thread_local_blocks.size = 0;
+    thread_local_blocks.removal_count = removal_count;
+  }
+  return thread_local_blocks;
+}
+
+/*!
+ * \return Port construction batch of current thread - closed if any module has been removed since it was opened
+ * (component of batch might have been deleted and its memory reused)
+ */
+static tPortConstructionBatch& GetPortConstructionBatch()
+{
+  tPortConstructionBatch& batch = port_construction_batch;
+  if (batch.component && batch.removal_count != module_removal_counter.load(std::memory_order_acquire))
+  {
+    batch.component = NULL;
+  }
+  return batch;
+}
+
+/*!
+ * \param ptr Address to look up
+ * \param scan_length If not NULL, number of checked blocks is written to this variable
+ * \return Most recently added block of current thread that contains address ptr - or NULL if there is no such block
+ */
+static tThreadLocalBlock* FindThreadLocalBlock(void* ptr, uint64_t* scan_length = NULL)
+{
+  tThreadLocalBlocks& local = GetThreadLocalBlocks();
+  for (size_t i = local.size; i > 0; i--)
   {
-    if (module == reg[i].module)
+    tThreadLocalBlock& entry = local.blocks[i - 1];
+    if (ptr >= entry.block.address && ptr < entry.block.address + entry.block.size)
     {
-      reg.erase(reg.begin() + i);
-      return;
+      if (scan_length)
+      {
+        *scan_length = local.size - i + 1;
+      }
+      return &entry;
     }
   }
+  if (scan_length)
+  {
+    *scan_length = local.size;
+  }
+  return NULL;
 }
 
-core::tFrameworkElement* FindParent(void* ptr, bool abort_if_not_found)
+/*!
+ * Adds block to memory blocks of current thread
+ */
+static void AddThreadLocalBlock(const tThreadLocalBlock& new_entry)
+{
+  tThreadLocalBlocks& local = GetThreadLocalBlocks();
+  const tInstantiatedModule& block = new_entry.block;
+
+  // Remove blocks overlapping the new one (see AddMemoryBlock)
+  size_t remaining = 0;
+  for (size_t i = 0; i < local.size; i++)
+  {
+    const tInstantiatedModule& b = local.blocks[i].block;
+    if (b.address >= block.address + block.size || b.address + b.size <= block.address)
+    {
+      local.blocks[remaining] = local.blocks[i];
+      remaining++;
+    }
+  }
+  local.size = remaining;
+
+  if (local.size == local.blocks.size())
+  {
+    std::move(local.blocks.begin() + 1, local.blocks.end(), local.blocks.begin());
+    local.size--;
+  }
+  local.blocks[local.size] = new_entry;
+  local.size++;
+}
+
+/*!
+ * (mutex must be acquired)
+ *
+ * \return Slot referenced by handle - or NULL if handle is outdated or invalid
+ */
+static tMemoryBlockSlot* GetSlot(tMemoryBlockHandle handle)
+{
+  std::vector<tMemoryBlockSlot>& slots = GetStorage().slots;
+  if (handle.slot < slots.size() && slots[handle.slot].used && slots[handle.slot].generation == handle.generation)
+  {
+    return &slots[handle.slot];
+  }
+  return NULL;
+}
+
+/*!
+ * (mutex must be acquired)
+ *
+ * \return Slot of memory block that contains address ptr - or NULL if there is no such block
+ */
+static tMemoryBlockSlot* FindMemoryBlock(void* ptr)
+{
+  tStructureElementStorage& storage = GetStorage();
+  auto it = storage.reg.upper_bound(static_cast<char*>(ptr));
+  if (it == storage.reg.begin())
+  {
+    return NULL;
+  }
+  --it;
+  tMemoryBlockSlot& slot = storage.slots[it->second];
+  return (ptr < slot.block.address + slot.block.size) ? &slot : NULL;
+}
+
+/*!
+ * Removes memory block in slot from register
+ * (mutex must be acquired)
+ */
+static void FreeSlot(tMemoryBlockSlot& slot)
 {
-  rrlib::thread::tLock lock(GetMutex());
-  std::vector<tInstantiatedModule>& reg = GetRegister();
-  for (int i = reg.size() - 1; i >= 0; i--) // reverse direction, because relevant module usually is at the end (the most recently added)
+  tStructureElementStorage& storage = GetStorage();
+  storage.reg.erase(slot.index_entry);
+  slot.used = false;
+  slot.generation = (slot.generation == std::numeric_limits<uint32_t>::max()) ? 1 : (slot.generation + 1);
+  storage.free_slots.push_back(&slot - &storage.slots[0]);
+}
+
+void AddMemoryBlock(void* address, size_t size)
+{
+  tThreadLocalBlock entry = { { static_cast<char*>(address), size, NULL }, { 0, 0 } };
+  char* start = entry.block.address;
   {
-    if (ptr >= reg[i].address && ptr < reg[i].address + reg[i].size)
+    tRegisterLock lock(GetMutex());
+    FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Adding memory block at ", address, " with size ", size);
+    tStructureElementStorage& storage = GetStorage();
+
+    // Blocks overlapping the new one are left-overs from components whose construction failed (memory has been freed and is now reused) => remove them
+    auto it = storage.reg.lower_bound(start);
+    if (it != storage.reg.begin())
     {
-      assert(reg[i].module != NULL);
-      return reg[i].module;
+      tMemoryBlockSlot& previous = storage.slots[std::prev(it)->second];
+      if (previous.block.address + previous.block.size > start)
+      {
+        --it;
+      }
     }
+    while (it != storage.reg.end() && it->first < start + size)
+    {
+      FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Removing outdated memory block at ", static_cast<void*>(it->first));
+      tMemoryBlockSlot& outdated = storage.slots[it->second];
+      ++it;
+      FreeSlot(outdated);
+    }
+
+    if (storage.free_slots.empty())
+    {
+      storage.free_slots.push_back(storage.slots.size());
+      storage.slots.emplace_back();
+      storage.slots.back().generation = 1;
+      storage.slots.back().used = false;
+    }
+    entry.handle.slot = storage.free_slots.back();
+    storage.free_slots.pop_back();
+    tMemoryBlockSlot& slot = storage.slots[entry.handle.slot];
+    entry.handle.generation = slot.generation;
+    slot.block = entry.block;
+    slot.index_entry = storage.reg.emplace_hint(it, start, entry.handle.slot);
+    slot.used = true;
+  }
+  AddThreadLocalBlock(entry);
+}
+
+tMemoryBlockHandle AddModule(core::tFrameworkElement* module)
+{
+  tMemoryBlockHandle handle = { 0, 0 };
+  tThreadLocalBlock* local_entry = FindThreadLocalBlock(module);
+  if (local_entry)
+  {
+    local_entry->block.module = module;
+    handle = local_entry->handle;
+  }
+
+  tRegisterLock lock(GetMutex());
+  FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Adding module ", module, "...");
+  tMemoryBlockSlot* slot = local_entry ? GetSlot(handle) : FindMemoryBlock(module);
+  if (slot)
+  {
+    assert(slot->block.module == NULL);
+    FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Module resides in memory block ", static_cast<void*>(slot->block.address));
+    slot->block.module = module;
+    handle.slot = slot - &GetStorage().slots[0];
+    handle.generation = slot->generation;
+    return handle;
+  }
+  return tMemoryBlockHandle { 0, 0 };
+}
+
+void RemoveModule(tMemoryBlockHandle handle)
+{
+  module_removal_counter.fetch_add(1, std::memory_order_release);
+
+  tRegisterLock lock(GetMutex());
+  tMemoryBlockSlot* slot = GetSlot(handle);
+  if (slot)
+  {
+    FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Removing module ", slot->block.module);
+    FreeSlot(*slot);
+  }
+}
+
+void RetireMemoryBlock(tMemoryBlockHandle handle)
+{
+  tRegisterLock lock(GetMutex());
+  tMemoryBlockSlot* slot = GetSlot(handle);
+  if (slot)
+  {
+    FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, "Retiring memory block of module ", slot->block.module);
+    FreeSlot(*slot);
+  }
+}
+
+void OpenPortConstructionBatch(core::tFrameworkElement* component, tMemoryBlockHandle handle)
+{
+  tPortConstructionBatch& batch = port_construction_batch;
+  uint64_t removal_count = module_removal_counter.load(std::memory_order_acquire);
+  tRegisterLock lock(GetMutex());
+  tMemoryBlockSlot* slot = GetSlot(handle);
+  if (slot && slot->block.module == component)
+  {
+    batch.component = component;
+    batch.address = slot->block.address;
+    batch.size = slot->block.size;
+    batch.type = NULL;
+    batch.module_ports = NULL;
+    batch.removal_count = removal_count;
+  }
+}
+
+void ClosePortConstructionBatch(core::tFrameworkElement* component)
+{
+  if (port_construction_batch.component == component)
+  {
+    port_construction_batch.component = NULL;
+  }
+}
+
+core::tFrameworkElement* FindParent(void* ptr, bool abort_if_not_found)
+{
+  const tPortConstructionBatch& batch = GetPortConstructionBatch();
+  if (batch.component && ptr >= batch.address && ptr < batch.address + batch.size)
+  {
+    RecordParentLookup(1, true);
+    return batch.component;
+  }
+
+  uint64_t scan_length = 0;
+  tThreadLocalBlock* local_entry = FindThreadLocalBlock(ptr, &scan_length);
+  if (local_entry && local_entry->block.module)
+  {
+    RecordParentLookup(scan_length, true);
+    return local_entry->block.module;
+  }
+
+  RecordParentLookup(scan_length + 1, false); // binary search in shared register counts as one block
+  tRegisterLock lock(GetMutex());
+  tMemoryBlockSlot* slot = FindMemoryBlock(ptr);
+  if (slot)
+  {
+    assert(slot->block.module != NULL);
+    return slot->block.module;
   }
   if (abort_if_not_found)
   {
@@ -161,32 +562,66 @@ std::string& GetAutoGeneratedPortName(core::tFrameworkElement* parent, size_t po
 {
   static std::string unresolved("(unresolved port name)");
 
-  rrlib::thread::tLock lock(GetMutex());
-  std::vector<tModulePorts>& reg = GetModuleTypeRegister();
+  if (statistics_enabled.load(std::memory_order_relaxed))
+  {
+    port_name_lookups.fetch_add(1, std::memory_order_relaxed);
+  }
+  const std::type_info& type = typeid(*parent);
 
-  // normalize type String (remove any template arguments)
-  std::string s(rrlib::util::Demangle(typeid(*parent).name()));
-  if (s.find('<') != std::string::npos)
+  // Names of the type in an open batch were materialized by this thread and are not modified anymore - so no lock is needed
+  tPortConstructionBatch& batch = GetPortConstructionBatch();
+  bool in_batch = parent == batch.component;
+  if (in_batch && batch.module_ports && *batch.type == type && port_index < batch.module_ports->ports.size())
   {
-    s = s.substr(0, s.find('<'));
+    return batch.module_ports->ports[port_index];
   }
 
-  for (size_t i = 0; i < reg.size(); i++)
+  tRegisterLock lock(GetPortNameMutex());
+  tModuleTypeCache& cache = GetModuleTypeCache();
+  auto cached = cache.find(type);
+  tModulePorts* module_ports = cached != cache.end() ? cached->second : NULL;
+
+  if (!module_ports)
   {
-    if (s.compare(reg[i].name) == 0) // Equals?
+    if (statistics_enabled.load(std::memory_order_relaxed))
     {
-      if (port_index < reg[i].ports.size())
-      {
-        return reg[i].ports[port_index];
-      }
-      else
-      {
-        break;
-      }
+      port_name_type_resolutions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // normalize type String (remove any template arguments)
+    std::string s(rrlib::util::Demangle(type.name()));
+    if (s.find('<') != std::string::npos)
+    {
+      s = s.substr(0, s.find('<'));
     }
+
+    tModuleTypeMap& reg = GetModuleTypeRegister();
+    auto it = reg.find(s);
+    if (it == reg.end())
+    {
+      FINROC_LOG_PRINT_STATIC(WARNING, "Cannot resolve port name for module type ", s, " index ", port_index, ". Automatic port names are only available for a module's plain member variables. For other ports, the name needs to be explicitly specified when calling the constructor. If this is a template module, it is possibly not included in the 'make.xml'.");
+      return unresolved;
+    }
+    module_ports = &it->second;
+    cache.emplace(type, module_ports);
+  }
+
+  if (module_ports->static_port_count > module_ports->ports.size())
+  {
+    module_ports->ports.assign(module_ports->static_ports, module_ports->static_ports + module_ports->static_port_count);
+  }
+  if (in_batch)
+  {
+    batch.type = &type;
+    batch.module_ports = module_ports;
   }
 
-  FINROC_LOG_PRINT_STATIC(WARNING, "Cannot resolve port name for module type ", s, " index ", port_index, ". Automatic port names are only available for a module's plain member variables. For other ports, the name needs to be explicitly specified when calling the constructor. If this is a template module, it is possibly not included in the 'make.xml'.");
+  if (port_index < module_ports->ports.size())
+  {
+    return module_ports->ports[port_index];
+  }
+
+  FINROC_LOG_PRINT_STATIC(WARNING, "Cannot resolve port name for module type ", rrlib::util::Demangle(type.name()), " index ", port_index, ". Automatic port names are only available for a module's plain member variables. For other ports, the name needs to be explicitly specified when calling the constructor. If this is a template module, it is possibly not included in the 'make.xml'.");
   return unresolved;
 }
 
@@ -196,13 +631,53 @@ std::string& GetAutoGeneratedPortName(core::tFrameworkElement* parent, size_t po
  */
 void AddPortNamesForModuleType(const std::string& name, const std::vector<std::string>& names)
 {
-  rrlib::thread::tLock lock(GetMutex());
-  std::vector<tModulePorts>& reg = GetModuleTypeRegister();
+  tRegisterLock lock(GetPortNameMutex());
+  tModulePorts mp = { name, names, NULL, 0 };
+  GetModuleTypeRegister().emplace(name, std::move(mp)); // if a type is registered twice, the first entry is used (as before)
+}
 
-  tModulePorts mp;
-  mp.name = name;
-  mp.ports = names;
-  reg.push_back(mp);
+void AddPortNamesForModuleType(const char* name, const char* const* names, size_t name_count)
+{
+  tRegisterLock lock(GetPortNameMutex());
+  tModulePorts mp = { name, std::vector<std::string>(), names, name_count };
+  GetModuleTypeRegister().emplace(name, std::move(mp));
+}
+
+void AddPortNamesForModuleType(const std::type_info& type, const char* const* names, size_t name_count)
+{
+  tRegisterLock lock(GetPortNameMutex());
+  tModulePorts mp = { std::string(), std::vector<std::string>(), names, name_count };
+  auto result = GetModuleRttiTypeRegister().emplace(type, std::move(mp));
+  GetModuleTypeCache().emplace(type, &result.first->second);
+}
+
+tRegisterStatistics GetRegisterStatistics()
+{
+  tRegisterStatistics result;
+  result.parent_lookups = parent_lookups.load();
+  result.thread_local_hits = thread_local_hits.load();
+  int64_t start = statistics_start_nanoseconds.load();
+  double seconds = start ? (SteadyClockNanoseconds() - start) / 1000000000.0 : 0;
+  result.parent_lookups_per_second = seconds > 0 ? result.parent_lookups / seconds : 0;
+  result.average_scan_length = result.parent_lookups ? static_cast<double>(scanned_blocks.load()) / result.parent_lookups : 0;
+  result.max_scan_length = max_scan_length.load();
+  result.port_name_lookups = port_name_lookups.load();
+  result.port_name_type_resolutions = port_name_type_resolutions.load();
+  result.mutex_wait_time = std::chrono::duration_cast<rrlib::time::tDuration>(std::chrono::nanoseconds(mutex_wait_nanoseconds.load()));
+  {
+    rrlib::thread::tLock lock(GetMutex());
+    result.live_memory_blocks = GetStorage().reg.size();
+  }
+  return result;
+}
+
+void SetRegisterStatisticsEnabled(bool enabled)
+{
+  if (enabled && (!statistics_start_nanoseconds.load()))
+  {
+    statistics_start_nanoseconds.store(SteadyClockNanoseconds());
+  }
+  statistics_enabled.store(enabled);
 }
 
 //----------------------------------------------------------------------
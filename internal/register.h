@@ -38,7 +38,10 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <cstdint>
+#include <typeinfo>
 #include "core/tFrameworkElement.h"
+#include "rrlib/time/time.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -66,6 +69,15 @@ struct tModulePorts
 
   /*! port name in module */
   std::vector<std::string> ports;
+
+  /*!
+   * Port names in static storage (e.g. constexpr array in generated code).
+   * They are copied to 'ports' when the module type is instantiated for the first time.
+   */
+  const char* const* static_ports;
+
+  /*! Number of entries in static_ports */
+  size_t static_port_count;
 };
 
 //! Info on a single instantiated module */
@@ -81,6 +93,51 @@ struct tInstantiatedModule
   core::tFrameworkElement* module;
 };
 
+//! Handle to memory block in register
+struct tMemoryBlockHandle
+{
+  /*! Index of slot in register */
+  uint32_t slot;
+
+  /*! Generation of slot (used to detect outdated handles - 0 is invalid) */
+  uint32_t generation;
+
+  /*! \return Does handle refer to a memory block? (it is possibly outdated) */
+  bool IsValid() const
+  {
+    return generation != 0;
+  }
+};
+
+//! Statistics on usage of the register (see GetRegisterStatistics())
+struct tRegisterStatistics
+{
+  /*! Number of FindParent() calls */
+  uint64_t parent_lookups;
+
+  /*! Number of FindParent() calls that were answered from the calling thread's recently allocated blocks (without locking) */
+  uint64_t thread_local_hits;
+
+  /*! Parent lookups per second since statistics were enabled */
+  double parent_lookups_per_second;
+
+  /*! Average and maximum number of memory blocks checked in FindParent() (a lookup in the shared register counts as one block) */
+  double average_scan_length;
+  uint64_t max_scan_length;
+
+  /*! Number of GetAutoGeneratedPortName() calls */
+  uint64_t port_name_lookups;
+
+  /*! Number of times a module type had to be demangled to look up port names */
+  uint64_t port_name_type_resolutions;
+
+  /*! Total time spent waiting for register mutexes */
+  rrlib::time::tDuration mutex_wait_time;
+
+  /*! Number of memory blocks currently in register (components under construction and components not yet initialized) */
+  size_t live_memory_blocks;
+};
+
 //----------------------------------------------------------------------
 // Function declarations
 //----------------------------------------------------------------------
@@ -93,15 +150,50 @@ void AddMemoryBlock(void* address, size_t size);
 
 /*!
  * Add Module to register
- * (should only be called by tModuleBase and tGroup)
+ * (should only be called by tComponent)
+ *
+ * \return Handle to memory block that module resides in (invalid if module was not allocated with tComponent::operator new)
  */
-void AddModule(core::tFrameworkElement* module);
+tMemoryBlockHandle AddModule(core::tFrameworkElement* module);
 
 /*!
- * Add Module to register
- * (should only be called by tModuleBase and tGroup)
+ * Remove Module from register
+ * (should only be called by tComponent)
+ *
+ * \param handle Handle returned by AddModule()
+ */
+void RemoveModule(tMemoryBlockHandle handle);
+
+/*!
+ * Removes module's memory block from the register, as no further ports will be constructed as its members.
+ * This keeps the register small (it then mainly contains components currently under construction).
+ * (should only be called by tComponent)
+ *
+ * \param handle Handle returned by AddModule()
+ */
+void RetireMemoryBlock(tMemoryBlockHandle handle);
+
+/*!
+ * Opens batch construction context for the member ports of a component on the current thread.
+ * While the batch is open, ports residing in the component's memory block obtain their parent
+ * and their auto-generated names without locking or register lookups.
+ * Only one batch is open per thread - opening a batch closes any other one.
+ * The batch is discarded as soon as any module is removed (like the thread-local memory blocks),
+ * as the component might have been deleted and its memory reused.
+ * (should only be called by tComponent - before its member ports are constructed)
+ *
+ * \param component Component whose member ports are about to be constructed
+ * \param handle Handle returned by AddModule()
  */
-void RemoveModule(core::tFrameworkElement* module);
+void OpenPortConstructionBatch(core::tFrameworkElement* component, tMemoryBlockHandle handle);
+
+/*!
+ * Closes batch construction context of component on the current thread (if it is still open)
+ * (should only be called by tComponent)
+ *
+ * \param component Component whose batch to close
+ */
+void ClosePortConstructionBatch(core::tFrameworkElement* component);
 
 /*!
  * Add port names for a module type
@@ -109,8 +201,32 @@ void RemoveModule(core::tFrameworkElement* module);
  */
 void AddPortNamesForModuleType(const std::string& name, const std::vector<std::string>& names);
 
+/*!
+ * Add port names for a module type - without copying them
+ * (typically called by auto-generated code)
+ *
+ * \param name Demangled RTTI name of module type (without template arguments)
+ * \param names Port names (must remain valid as long as the register exists - e.g. constexpr array)
+ * \param name_count Number of port names
+ */
+void AddPortNamesForModuleType(const char* name, const char* const* names, size_t name_count);
+
+/*!
+ * Add port names for a module type - without copying them
+ * (no demangling of type name is required to look up names for this type;
+ *  not suitable for template modules, as names are only used for exactly this type)
+ *
+ * \param type RTTI type of module
+ * \param names Port names (must remain valid as long as the register exists - e.g. constexpr array)
+ * \param name_count Number of port names
+ */
+void AddPortNamesForModuleType(const std::type_info& type, const char* const* names, size_t name_count);
+
 /*!
  * \return Parent module/group of port class at address ptr
+ *
+ * Components recently allocated by the calling thread are looked up without acquiring a lock.
+ * Therefore, several threads may construct components in parallel efficiently.
  */
 core::tFrameworkElement* FindParent(void* ptr, bool abort_if_not_found = true);
 
@@ -124,6 +240,34 @@ core::tFrameworkElement* FindParent(void* ptr, bool abort_if_not_found = true);
  */
 std::string& GetAutoGeneratedPortName(core::tFrameworkElement* parent, size_t port_index);
 
+/*!
+ * \return Statistics on usage of register (counters are only updated while statistics are enabled)
+ */
+tRegisterStatistics GetRegisterStatistics();
+
+/*!
+ * Enables or disables collection of register statistics (disabled by default; enabled with --profiling)
+ */
+void SetRegisterStatisticsEnabled(bool enabled);
+
+/*!
+ * Registers port names of module type TModule during static initialization.
+ * Names are neither copied nor demangled at this point.
+ *
+ * Usage (e.g. in generated code):
+ *   static constexpr const char* cPORT_NAMES[] = { "Input Signal", "Output Signal" };
+ *   static internal::tPortNameRegistration<mTestModule> cPORT_NAME_REGISTRATION(cPORT_NAMES);
+ */
+template <typename TModule>
+struct tPortNameRegistration
+{
+  template <size_t Tcount>
+  tPortNameRegistration(const char* const(&names)[Tcount])
+  {
+    AddPortNamesForModuleType(typeid(TModule), names, Tcount);
+  }
+};
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
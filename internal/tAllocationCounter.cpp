@@ -0,0 +1,176 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tAllocationCounter.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tAllocationCounter.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include "rrlib/logging/messages.h"
+
+#ifdef __linux__
+#include <execinfo.h>
+#endif
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Global allocation detection mode */
+static std::atomic<tAllocationDetectionMode> mode(tAllocationDetectionMode::DISABLED);
+
+/*! Have malloc hooks been installed? */
+static std::atomic<bool> hooks_installed(false);
+
+/*!
+ * Active allocation counter of current thread
+ * (trivially initialized and with initial-exec TLS model - so accessing it from malloc hooks never allocates or calls into the dynamic linker)
+ */
+static thread_local tAllocationCounter* active_counter __attribute__((tls_model("initial-exec"))) = nullptr;
+
+tAllocationCounter::tAllocationCounter(bool capture_backtrace) :
+  count(0),
+  capture_backtrace(capture_backtrace),
+  backtrace_logged(false),
+  backtrace(),
+  backtrace_size(0),
+  previous(nullptr)
+{}
+
+tAllocationDetectionMode tAllocationCounter::GetMode()
+{
+  return mode.load(std::memory_order_relaxed);
+}
+
+bool tAllocationCounter::HooksInstalled()
+{
+  return hooks_installed.load(std::memory_order_relaxed);
+}
+
+void tAllocationCounter::LogBacktrace(const std::string& description)
+{
+  if (!HasBacktrace())
+  {
+    return;
+  }
+  backtrace_logged = true;
+  std::stringstream stream;
+#ifdef __linux__
+  char** symbols = backtrace_symbols(backtrace, backtrace_size);
+  for (int i = 0; i < backtrace_size; i++)
+  {
+    stream << "\n  " << (symbols ? symbols[i] : "?");
+  }
+  free(symbols);
+#endif
+  FINROC_LOG_PRINT_STATIC(WARNING, "Heap allocation in ", description, ". Backtrace:", stream.str());
+}
+
+void tAllocationCounter::OnAllocation()
+{
+  tAllocationCounter* counter = active_counter;
+  if (counter)
+  {
+    counter->count++;
+    if (counter->capture_backtrace && counter->backtrace_size == 0)
+    {
+#ifdef __linux__
+      active_counter = nullptr; // backtrace() may allocate on first call
+      counter->backtrace_size = ::backtrace(counter->backtrace, cMAX_BACKTRACE_SIZE);
+      active_counter = counter;
+#endif
+    }
+  }
+}
+
+void tAllocationCounter::SetHooksInstalled()
+{
+  hooks_installed.store(true, std::memory_order_relaxed);
+}
+
+void tAllocationCounter::SetMode(tAllocationDetectionMode new_mode)
+{
+  mode.store(new_mode, std::memory_order_relaxed);
+}
+
+void tAllocationCounter::Start()
+{
+  count = 0;
+  previous = active_counter;
+  active_counter = this;
+}
+
+uint64_t tAllocationCounter::Stop()
+{
+  active_counter = previous;
+  previous = nullptr;
+  return count;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
@@ -0,0 +1,191 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tAllocationCounter.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tAllocationCounter
+ *
+ * \b tAllocationCounter
+ *
+ * Counts heap allocations (malloc(), calloc(), realloc(), aligned allocation functions - and operator new,
+ * which uses them) of the calling thread between Start() and Stop() -
+ * e.g. in order to find allocations in a module's Update(), Sense() or Control() call.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__tAllocationCounter_h__
+#define __plugins__structure__internal__tAllocationCounter_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*! Allocation detection modes */
+enum class tAllocationDetectionMode
+{
+  DISABLED,  //!< Allocations are not counted
+  COUNT,     //!< Allocations are counted
+  STRICT     //!< Allocations are counted - and a backtrace of the first allocation is logged
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Counts heap allocations of calling thread
+/*!
+ * Counts heap allocations of the calling thread between Start() and Stop().
+ *
+ * Allocations are reported by the hooks in the separate, opt-in 'allocation_detection'
+ * library (allocation_detection/malloc_hooks.cpp), which interposes malloc(), calloc(), realloc(),
+ * memalign(), aligned_alloc() and posix_memalign(). It is only linked to applications that
+ * want allocation detection (or loaded with LD_PRELOAD) - the structure library itself does not
+ * intercept any allocations. Without the hooks, counters always report zero allocations
+ * (see HooksInstalled()). Allocations via operator new are covered, as it is implemented with malloc().
+ * When no counter is active on the calling thread, the hooks only add
+ * a check of a thread-local pointer to each allocation.
+ *
+ * If a backtrace is to be captured, it is captured at the first allocation
+ * (only addresses - resolving symbols is deferred to LogBacktrace()).
+ */
+class tAllocationCounter
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param capture_backtrace Capture backtrace of first allocation?
+   */
+  explicit tAllocationCounter(bool capture_backtrace);
+
+  /*!
+   * \return Global allocation detection mode
+   */
+  static tAllocationDetectionMode GetMode();
+
+  /*!
+   * \return Are malloc hooks installed that report allocations? (see class description)
+   */
+  static bool HooksInstalled();
+
+  /*!
+   * \return Has a backtrace been captured that has not been logged yet?
+   */
+  bool HasBacktrace() const
+  {
+    return backtrace_size > 0 && (!backtrace_logged);
+  }
+
+  /*!
+   * Logs captured backtrace (only once)
+   *
+   * \param description Description of code that allocated memory (e.g. function and module name)
+   */
+  void LogBacktrace(const std::string& description);
+
+  /*!
+   * Called by malloc hooks on every allocation
+   * (must not allocate memory)
+   */
+  static void OnAllocation();
+
+  /*!
+   * Called by malloc hooks when they are loaded
+   */
+  static void SetHooksInstalled();
+
+  /*!
+   * \param mode Global allocation detection mode (should be set before modules are initialized)
+   */
+  static void SetMode(tAllocationDetectionMode mode);
+
+  /*!
+   * Starts counting allocations of calling thread
+   * (counters may be nested - only the innermost one counts)
+   */
+  void Start();
+
+  /*!
+   * Stops counting allocations of calling thread
+   *
+   * \return Number of allocations since Start()
+   */
+  uint64_t Stop();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cMAX_BACKTRACE_SIZE = 32 };
+
+  /*! Number of allocations since Start() */
+  uint64_t count;
+
+  /*! Capture backtrace of first allocation? */
+  bool capture_backtrace;
+
+  /*! Has captured backtrace been logged? */
+  bool backtrace_logged;
+
+  /*! Captured backtrace */
+  void* backtrace[cMAX_BACKTRACE_SIZE];
+  int backtrace_size;
+
+  /*! Counter that was active when Start() was called */
+  tAllocationCounter* previous;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
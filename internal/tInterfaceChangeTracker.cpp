@@ -0,0 +1,362 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tInterfaceChangeTracker.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tInterfaceChangeTracker.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "core/tRuntimeEnvironment.h"
+#include "core/tRuntimeListener.h"
+#include "core/port/tConnector.h"
+#include "rrlib/thread/tLock.h"
+#include "plugins/data_ports/tGenericPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+static constexpr uint cMANDATORY_PORT_FLAGS_FOR_CHANGED_CHECK = (core::tFrameworkElementFlag::READY | core::tFrameworkElementFlag::PUSH_STRATEGY).Raw();
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*!
+ * Notifies trackers of structure changes in their port groups.
+ * Changes elsewhere in the application do not cause any tracker to rebuild its port list.
+ */
+class tStructureChangeListener : public core::tRuntimeListener
+{
+public:
+
+  /*! Adds tracker (is notified of structure changes in its port group) */
+  void Add(tInterfaceChangeTracker& tracker)
+  {
+    rrlib::thread::tLock lock(mutex);
+    trackers.emplace(&tracker.GetPortGroup(), &tracker);
+  }
+
+  /*! Removes tracker */
+  void Remove(tInterfaceChangeTracker& tracker)
+  {
+    rrlib::thread::tLock lock(mutex);
+    auto range = trackers.equal_range(&tracker.GetPortGroup());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second == &tracker)
+      {
+        trackers.erase(it);
+        return;
+      }
+    }
+  }
+
+private:
+
+  /*! Trackers by port group */
+  std::unordered_multimap<core::tFrameworkElement*, tInterfaceChangeTracker*> trackers;
+
+  /*! Mutex for trackers */
+  rrlib::thread::tMutex mutex;
+
+  virtual void OnConnectorChange(tEvent change_type, core::tConnector& connector) override
+  {
+    rrlib::thread::tLock lock(mutex);
+    NotifyTrackers(connector.Source().GetParent());
+    NotifyTrackers(connector.Destination().GetParent());
+  }
+
+  virtual void OnFrameworkElementChange(tEvent change_type, core::tFrameworkElement& element) override
+  {
+    if (element.IsPort())
+    {
+      rrlib::thread::tLock lock(mutex);
+      NotifyTrackers(element.GetParent());
+    }
+  }
+
+  virtual void OnUriConnectorChange(tEvent change_type, core::tUriConnector& connector) override
+  {
+  }
+
+  /*! Notifies trackers of port group (mutex must be acquired) */
+  void NotifyTrackers(core::tFrameworkElement* port_group)
+  {
+    auto range = trackers.equal_range(port_group);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      it->second->OnStructureChange();
+    }
+  }
+};
+
+/*!
+ * \return Listener for structure changes
+ */
+tStructureChangeListener& GetStructureChangeListener()
+{
+  // Listener is never deleted, as runtime environment might notify it until the very end
+  static tStructureChangeListener* listener = []()
+  {
+    tStructureChangeListener* result = new tStructureChangeListener();
+    core::tRuntimeEnvironment::GetInstance().AddListener(*result);
+    return result;
+  }();
+  return *listener;
+}
+
+}
+
+tInterfaceChangeTracker::tInterfaceChangeTracker(core::tFrameworkElement& port_group) :
+  port_group(port_group),
+  bitmap(nullptr),
+  bitmaps(),
+  ports(),
+  listeners(),
+  orphaned_listeners(),
+  changed_ports(),
+  previously_changed_ports(),
+  changed_port_listeners(),
+  change_sequence(0),
+  structure_revision(1),
+  collected_structure_revision(0)
+{
+  GetStructureChangeListener().Add(*this);
+}
+
+tInterfaceChangeTracker::~tInterfaceChangeTracker()
+{
+  GetStructureChangeListener().Remove(*this);
+}
+
+void tInterfaceChangeTracker::CollectPorts()
+{
+  collected_structure_revision = structure_revision.load(std::memory_order_acquire);
+  for (tTrackedPort & tracked_port : ports)
+  {
+    tracked_port.listener->index.store(cNOT_TRACKED, std::memory_order_relaxed);
+  }
+  ports.clear();
+  previously_changed_ports.clear();
+
+  for (auto it = port_group.ChildPortsBegin(); it != port_group.ChildPortsEnd(); ++it)
+  {
+    if ((it->GetAllFlags().Raw() & cMANDATORY_PORT_FLAGS_FOR_CHANGED_CHECK) != cMANDATORY_PORT_FLAGS_FOR_CHANGED_CHECK)
+    {
+      continue;
+    }
+    data_ports::common::tAbstractDataPort& port = static_cast<data_ports::common::tAbstractDataPort&>(*it);
+    std::unique_ptr<tPortChangeListener>& listener = listeners[port.GetHandle()];
+    if (listener && listener->port != &port)
+    {
+      orphaned_listeners.push_back(std::move(listener));
+    }
+    if (!listener)
+    {
+      listener.reset(new tPortChangeListener(*this, port));
+      data_ports::tGenericPort::Wrap(port).AddPortListenerSimple(*listener);
+    }
+    ports.push_back(tTrackedPort { &port, listener.get() });
+  }
+
+  // Provide bitmap with sufficient size
+  size_t word_count = (ports.size() + 63) / 64;
+  tBitmap* current_bitmap = bitmap.load(std::memory_order_relaxed);
+  if ((!current_bitmap) || current_bitmap->word_count < word_count)
+  {
+    std::unique_ptr<tBitmap> new_bitmap(new tBitmap());
+    new_bitmap->word_count = std::max<size_t>(word_count, current_bitmap ? 2 * current_bitmap->word_count : 1);
+    new_bitmap->words.reset(new std::atomic<uint64_t>[new_bitmap->word_count]);
+    for (size_t i = 0; i < new_bitmap->word_count; i++)
+    {
+      new_bitmap->words[i].store(0, std::memory_order_relaxed);
+    }
+    bitmap.store(new_bitmap.get(), std::memory_order_release);
+    bitmaps.push_back(std::move(new_bitmap));
+  }
+
+  // Mark all ports as changed - as changes might have been missed
+  for (size_t i = 0; i < ports.size(); i++)
+  {
+    ports[i].listener->index.store(i, std::memory_order_relaxed);
+    MarkChanged(i);
+  }
+
+  // Keep changed ports that are still tracked (changes might be kept in next call to ProcessChangedFlags())
+  size_t kept = 0;
+  for (size_t i = 0; i < changed_ports.size(); i++)
+  {
+    tPortChangeListener* listener = changed_port_listeners[i];
+    listener->listed = listener->index.load(std::memory_order_relaxed) != cNOT_TRACKED;
+    if (listener->listed)
+    {
+      changed_ports[kept] = changed_ports[i];
+      changed_port_listeners[kept] = listener;
+      kept++;
+    }
+  }
+  changed_ports.resize(kept);
+  changed_port_listeners.resize(kept);
+
+  // Avoid allocating memory in ProcessChangedFlags()
+  changed_ports.reserve(ports.size());
+  previously_changed_ports.reserve(ports.size());
+  changed_port_listeners.reserve(ports.size());
+}
+
+void tInterfaceChangeTracker::MarkChanged(uint32_t index)
+{
+  tBitmap* current_bitmap = bitmap.load(std::memory_order_acquire);
+  if (current_bitmap && index / 64 < current_bitmap->word_count)
+  {
+    current_bitmap->words[index / 64].fetch_or(static_cast<uint64_t>(1) << (index % 64), std::memory_order_release);
+  }
+}
+
+bool tInterfaceChangeTracker::ProcessChangedFlags(bool keep_previous_changes)
+{
+  UpdatePortList();
+
+  // Reset custom changed flags of ports that changed in last call
+  if (!keep_previous_changes)
+  {
+    for (tPortChangeListener * listener : changed_port_listeners)
+    {
+      listener->listed = false;
+    }
+    changed_port_listeners.clear();
+    std::swap(changed_ports, previously_changed_ports);
+    changed_ports.clear();
+    for (data_ports::common::tAbstractDataPort * port : previously_changed_ports)
+    {
+      port->SetCustomChangedFlag(data_ports::tChangeStatus::NO_CHANGE);
+    }
+  }
+
+  // Process ports whose bits are set
+  bool change_detected = false;
+  tBitmap& current_bitmap = *bitmap.load(std::memory_order_relaxed);
+  size_t word_count = (ports.size() + 63) / 64;
+  for (size_t i = 0; i < word_count; i++)
+  {
+    uint64_t word = current_bitmap.words[i].exchange(0, std::memory_order_acquire);
+    while (word)
+    {
+      uint32_t index = i * 64 + __builtin_ctzll(word);
+      word &= word - 1;
+      if (index >= ports.size())
+      {
+        break;
+      }
+      data_ports::common::tAbstractDataPort& port = *ports[index].port;
+      tPortChangeListener& listener = *ports[index].listener;
+      bool changed = port.HasChanged();
+      port.ResetChanged();
+      if (listener.listed)
+      {
+        continue; // port is in changed_ports already (previous changes are kept)
+      }
+      port.SetCustomChangedFlag(changed ? data_ports::tChangeStatus::CHANGED : data_ports::tChangeStatus::NO_CHANGE);
+      if (changed)
+      {
+        if (!change_detected)
+        {
+          change_detected = true;
+          change_sequence++;
+        }
+        listener.change_sequence = change_sequence;
+        listener.listed = true;
+        changed_ports.push_back(&port);
+        changed_port_listeners.push_back(&listener);
+      }
+    }
+  }
+  return !changed_ports.empty();
+}
+
+uint64_t tInterfaceChangeTracker::GetChangeSequence(const core::tAbstractPort& port) const
+{
+  auto it = listeners.find(port.GetHandle());
+  return (it != listeners.end() && it->second->port == &port) ? it->second->change_sequence : 0;
+}
+
+void tInterfaceChangeTracker::UpdatePortList()
+{
+  if (collected_structure_revision != structure_revision.load(std::memory_order_acquire))
+  {
+    CollectPorts();
+  }
+}
+
+void tInterfaceChangeTracker::tPortChangeListener::OnPortChange(data_ports::tChangeContext& change_context)
+{
+  uint32_t port_index = index.load(std::memory_order_relaxed);
+  if (port_index != cNOT_TRACKED)
+  {
+    tracker.MarkChanged(port_index);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
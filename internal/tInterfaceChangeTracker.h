@@ -0,0 +1,253 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tInterfaceChangeTracker.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tInterfaceChangeTracker
+ *
+ * \b tInterfaceChangeTracker
+ *
+ * Tracks which ports of a module interface have changed.
+ * Port listeners set a bit in an atomic bitmap when data arrives -
+ * so processing changed flags only requires visiting the changed ports.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__tInterfaceChangeTracker_h__
+#define __plugins__structure__internal__tInterfaceChangeTracker_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "plugins/data_ports/common/tAbstractDataPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Tracks changed ports of module interface
+/*!
+ * Tracks which ports of a module interface (port group) have changed.
+ * Only ports eligible for changed flag processing (ready ports with push strategy) are tracked.
+ * Port listeners set a bit in an atomic bitmap when data arrives.
+ * ProcessChangedFlags() fetches and clears the bitmap with one atomic exchange per 64 ports
+ * and only visits the ports whose bits are set (and the ones that changed in the previous call).
+ *
+ * The list of ports is rebuilt whenever ports in the port group are added, changed or removed,
+ * or connectors of these ports change.
+ * Listeners cannot be removed from ports - so they are kept until the tracker is deleted
+ * (this must not happen before the interface's ports are deleted - e.g. with the module).
+ */
+class tInterfaceChangeTracker
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param port_group Port group to track
+   */
+  tInterfaceChangeTracker(core::tFrameworkElement& port_group);
+
+  ~tInterfaceChangeTracker();
+
+  /*!
+   * \return Ports that changed in last call to ProcessChangedFlags()
+   *         (and in preceding calls - as long as ProcessChangedFlags() was called with keep_previous_changes)
+   */
+  const std::vector<data_ports::common::tAbstractDataPort*>& GetChangedPorts() const
+  {
+    return changed_ports;
+  }
+
+  /*!
+   * \return Change sequence number of interface: incremented whenever ProcessChangedFlags() detects a change (0 if no change was detected yet)
+   */
+  uint64_t GetChangeSequence() const
+  {
+    return change_sequence;
+  }
+
+  /*!
+   * \param port Port in tracked port group
+   * \return Change sequence number of port: value of interface's change sequence number when port last changed (0 if port has not changed yet)
+   */
+  uint64_t GetChangeSequence(const core::tAbstractPort& port) const;
+
+  /*!
+   * \return Port group tracked by this object
+   */
+  core::tFrameworkElement& GetPortGroup()
+  {
+    return port_group;
+  }
+
+  /*!
+   * Rebuilds list of tracked ports if application structure has changed since it was last built.
+   * Only ports eligible for changed flag processing are tracked (ready ports with push strategy).
+   * (called by ProcessChangedFlags() - may be called before to build list in advance)
+   */
+  void UpdatePortList();
+
+  /*!
+   * Called when ports in the port group or their connectors have changed
+   * (port list is rebuilt in next call to UpdatePortList())
+   */
+  void OnStructureChange()
+  {
+    structure_revision.fetch_add(1, std::memory_order_release);
+  }
+
+  /*!
+   * Checks and resets changed flags of changed ports in port group
+   * and sets custom API changed flags accordingly
+   * (same behavior as iterating over all ports - see tModuleBase::ProcessChangedFlags()).
+   *
+   * \param keep_previous_changes Keep changes detected in previous call? (custom changed flags are not reset then - and changed ports are added to GetChangedPorts())
+   * \return Has any port changed since last call (that did not keep previous changes)?
+   */
+  bool ProcessChangedFlags(bool keep_previous_changes = false);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Marks a port as changed in tracker's bitmap */
+  class tPortChangeListener
+  {
+  public:
+    tPortChangeListener(tInterfaceChangeTracker& tracker, data_ports::common::tAbstractDataPort& port) : tracker(tracker), port(&port), index(cNOT_TRACKED), change_sequence(0), listed(false) {}
+
+    /*! Implementation of tPortListenerRaw */
+    void OnPortChange(data_ports::tChangeContext& change_context);
+
+    /*! Tracker that listener belongs to */
+    tInterfaceChangeTracker& tracker;
+
+    /*! Port that listener was added to */
+    data_ports::common::tAbstractDataPort* port;
+
+    /*! Index of port in tracker (cNOT_TRACKED if port is currently not tracked) */
+    std::atomic<uint32_t> index;
+
+    /*! Change sequence number of port (only accessed by thread calling ProcessChangedFlags()) */
+    uint64_t change_sequence;
+
+    /*! Is port in tracker's changed_ports? (only accessed by thread calling ProcessChangedFlags()) */
+    bool listed;
+  };
+
+  /*! Bitmap with one bit per tracked port */
+  struct tBitmap
+  {
+    size_t word_count;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+  };
+
+  /*! Tracked port */
+  struct tTrackedPort
+  {
+    data_ports::common::tAbstractDataPort* port;
+    tPortChangeListener* listener;
+  };
+
+  enum { cNOT_TRACKED = 0xFFFFFFFF };
+
+  /*! Port group tracked by this object */
+  core::tFrameworkElement& port_group;
+
+  /*! Current bitmap (replaced only when more ports need to be tracked than it can hold) */
+  std::atomic<tBitmap*> bitmap;
+
+  /*! All bitmaps allocated by tracker (replaced bitmaps might still be accessed by listeners - so they are deleted with the tracker) */
+  std::vector<std::unique_ptr<tBitmap>> bitmaps;
+
+  /*! Tracked ports (index in this vector equals bit in bitmap) */
+  std::vector<tTrackedPort> ports;
+
+  /*! Listeners of all ports that were tracked - by port handle (so that each port has only one listener) */
+  std::unordered_map<core::tFrameworkElement::tHandle, std::unique_ptr<tPortChangeListener>> listeners;
+
+  /*! Listeners of ports that were deleted (handle is used by another port now) */
+  std::vector<std::unique_ptr<tPortChangeListener>> orphaned_listeners;
+
+  /*! Ports whose custom changed flag was set in last call to ProcessChangedFlags() (and in preceding calls whose changes were kept) */
+  std::vector<data_ports::common::tAbstractDataPort*> changed_ports, previously_changed_ports;
+
+  /*! Listeners of ports in changed_ports (same order) */
+  std::vector<tPortChangeListener*> changed_port_listeners;
+
+  /*! Change sequence number of interface */
+  uint64_t change_sequence;
+
+  /*! Incremented whenever ports in port group or their connectors change */
+  std::atomic<uint64_t> structure_revision;
+
+  /*! Value of structure_revision when ports were collected (0 if ports have never been collected) */
+  uint64_t collected_structure_revision;
+
+  /*!
+   * Collects eligible ports in port group - and adds listeners to new ports.
+   * Afterwards all ports are marked as changed (a change could have been missed during rebuild).
+   */
+  void CollectPorts();
+
+  /*! Marks port with specified index as changed */
+  void MarkChanged(uint32_t index);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,278 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tLazyPortBase.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tLazyPortBase.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "core/tRuntimeEnvironment.h"
+#include "core/tRuntimeListener.h"
+#include "core/port/tUriConnector.h"
+#include "rrlib/thread/tLock.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Placeholder for lazy port in framework element tree (plain framework element with the port's name)
+ */
+class tLazyPortPlaceholder : public core::tFrameworkElement
+{
+public:
+
+  tLazyPortPlaceholder(core::tFrameworkElement* parent, const std::string& name, tLazyPortBase& lazy_port);
+
+  /*! Lazy port that placeholder represents (nullptr if lazy port was deleted or is being materialized; only accessed with placeholder register mutex acquired) */
+  tLazyPortBase* lazy_port;
+
+protected:
+
+  virtual ~tLazyPortPlaceholder();
+};
+
+namespace
+{
+
+/*!
+ * Register of all placeholders.
+ * Materializes lazy ports when a connector to a placeholder's path is created.
+ */
+class tPlaceholderRegister : public core::tRuntimeListener
+{
+public:
+
+  /*! Placeholders of lazy ports */
+  std::vector<tLazyPortPlaceholder*> placeholders;
+
+  /*! Mutex for placeholders and their lazy_port fields */
+  rrlib::thread::tMutex mutex;
+
+private:
+
+  virtual void OnConnectorChange(tEvent change_type, core::tConnector& connector) override
+  {
+  }
+
+  virtual void OnFrameworkElementChange(tEvent change_type, core::tFrameworkElement& element) override
+  {
+  }
+
+  virtual void OnUriConnectorChange(tEvent change_type, core::tUriConnector& connector) override
+  {
+    if (change_type != tEvent::ADD)
+    {
+      return;
+    }
+    std::vector<std::string> path = GetPathElements(connector.Uri().ToString());
+    if (path.empty())
+    {
+      return;
+    }
+
+    std::vector<tLazyPortBase*> lazy_ports;
+    {
+      rrlib::thread::tLock lock(mutex);
+      for (tLazyPortPlaceholder * placeholder : placeholders)
+      {
+        if (placeholder->lazy_port && PathMatches(*placeholder, path))
+        {
+          lazy_ports.push_back(placeholder->lazy_port);
+        }
+      }
+    }
+
+    // Called with runtime's structure mutex acquired - so lazy ports cannot be deleted concurrently
+    for (tLazyPortBase * lazy_port : lazy_ports)
+    {
+      lazy_port->MaterializePort();
+    }
+  }
+
+  /*!
+   * \param uri URI of connector
+   * \return Names of the elements the URI's path ends with (after any '..') - empty if URI does not refer to a local element
+   */
+  static std::vector<std::string> GetPathElements(const std::string& uri)
+  {
+    std::vector<std::string> result;
+    size_t first_separator = uri.find('/');
+    if (uri.find(':') < first_separator)
+    {
+      return result;  // URI with scheme (e.g. network connection)
+    }
+    size_t start = 0;
+    while (start <= uri.length())
+    {
+      size_t end = std::min(uri.find('/', start), uri.length());
+      std::string element = uri.substr(start, end - start);
+      if (element == "..")
+      {
+        result.clear();
+      }
+      else if (element.length() && element != ".")
+      {
+        result.push_back(element);
+      }
+      start = end + 1;
+    }
+    return result;
+  }
+
+  /*!
+   * \return True if the qualified name of placeholder ends with the specified path elements
+   */
+  static bool PathMatches(core::tFrameworkElement& placeholder, const std::vector<std::string>& path)
+  {
+    core::tFrameworkElement* element = &placeholder;
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+    {
+      if ((!element) || element->GetName() != *it)
+      {
+        return false;
+      }
+      element = element->GetParent();
+    }
+    return true;
+  }
+};
+
+/*!
+ * \return Placeholder register
+ */
+tPlaceholderRegister& GetPlaceholderRegister()
+{
+  // Register is never deleted, as runtime environment might notify it until the very end
+  static tPlaceholderRegister* placeholder_register = []()
+  {
+    tPlaceholderRegister* result = new tPlaceholderRegister();
+    core::tRuntimeEnvironment::GetInstance().AddListener(*result);
+    return result;
+  }();
+  return *placeholder_register;
+}
+
+}
+
+tLazyPortPlaceholder::tLazyPortPlaceholder(core::tFrameworkElement* parent, const std::string& name, tLazyPortBase& lazy_port) :
+  core::tFrameworkElement(parent, name),
+  lazy_port(&lazy_port)
+{
+  tPlaceholderRegister& placeholder_register = GetPlaceholderRegister();
+  rrlib::thread::tLock lock(placeholder_register.mutex);
+  placeholder_register.placeholders.push_back(this);
+}
+
+tLazyPortPlaceholder::~tLazyPortPlaceholder()
+{
+  tPlaceholderRegister& placeholder_register = GetPlaceholderRegister();
+  rrlib::thread::tLock lock(placeholder_register.mutex);
+  auto& placeholders = placeholder_register.placeholders;
+  placeholders.erase(std::remove(placeholders.begin(), placeholders.end(), this), placeholders.end());
+  if (lazy_port)
+  {
+    lazy_port->placeholder = nullptr; // deleted with its parent
+  }
+}
+
+tLazyPortBase::tLazyPortBase(const std::string& name, core::tFrameworkElement& container) :
+  name(name),
+  placeholder(new tLazyPortPlaceholder(&container, name, *this))
+{
+  if (container.IsReady())
+  {
+    placeholder->Init();
+  }
+}
+
+tLazyPortBase::~tLazyPortBase()
+{
+  rrlib::thread::tLock lock(GetPlaceholderRegister().mutex);
+  if (placeholder)
+  {
+    placeholder->lazy_port = nullptr;
+  }
+}
+
+void tLazyPortBase::DeletePlaceholder()
+{
+  tLazyPortPlaceholder* placeholder_to_delete = nullptr;
+  {
+    rrlib::thread::tLock lock(GetPlaceholderRegister().mutex);
+    std::swap(placeholder_to_delete, placeholder);
+    if (placeholder_to_delete)
+    {
+      placeholder_to_delete->lazy_port = nullptr;
+    }
+  }
+  if (placeholder_to_delete)
+  {
+    placeholder_to_delete->ManagedDelete();
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,136 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tLazyPortBase.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tLazyPortBase
+ *
+ * \b tLazyPortBase
+ *
+ * Base class of lazy ports (see tLazyPort.h).
+ * Maintains the placeholder that represents a lazy port in the framework element tree
+ * until the port is created.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__tLazyPortBase_h__
+#define __plugins__structure__internal__tLazyPortBase_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "core/tFrameworkElement.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tLazyPortPlaceholder;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Base class of lazy ports
+/*!
+ * Base class of lazy ports - so that components and placeholders can materialize them.
+ *
+ * Until its port is created, a lazy port is represented by a placeholder element
+ * with the port's name in the framework element tree (in the element the port will be child of).
+ * So tools (e.g. finstruct) show it and connections in config or structure files can refer to it:
+ * when a connector to the placeholder's path is created (e.g. from a config file), the port is
+ * created in place of the placeholder - and the connector connects to it.
+ */
+class tLazyPortBase
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! \return Name of port */
+  const std::string& GetName() const
+  {
+    return name;
+  }
+
+  /*! Creates port (if this has not been done yet) */
+  virtual void MaterializePort() = 0;
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * \param name Name of port
+   * \param container Framework element that port will be child of (placeholder is added there)
+   */
+  tLazyPortBase(const std::string& name, core::tFrameworkElement& container);
+
+  ~tLazyPortBase();
+
+  /*! Name of port */
+  std::string name;
+
+  /*!
+   * Deletes placeholder (if it has not been deleted yet).
+   * Must be called before port is created.
+   */
+  void DeletePlaceholder();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  friend class tLazyPortPlaceholder;
+
+  /*! Placeholder in framework element tree (nullptr after port has been created or placeholder was deleted with its parent) */
+  tLazyPortPlaceholder* placeholder;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
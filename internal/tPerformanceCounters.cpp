@@ -0,0 +1,205 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tPerformanceCounters.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tPerformanceCounters.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "rrlib/logging/messages.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+static const char* cCOUNTER_NAMES[tPerformanceCounters::eDIMENSION] = { "Instructions", "Cycles", "Cache Misses", "Branch Misses" };
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Are performance counters enabled? */
+static std::atomic<bool> enabled(false);
+
+namespace
+{
+
+#ifdef __linux__
+
+/*! Counter group of one thread (file descriptors are closed when thread exits) */
+class tThreadCounters
+{
+public:
+
+  tThreadCounters() : file_descriptors(), available(false)
+  {
+    file_descriptors.fill(-1);
+    static const uint64_t cCONFIGS[tPerformanceCounters::eDIMENSION] = { PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    for (size_t i = 0; i < tPerformanceCounters::eDIMENSION; i++)
+    {
+      perf_event_attr attributes;
+      memset(&attributes, 0, sizeof(attributes));
+      attributes.size = sizeof(attributes);
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.config = cCONFIGS[i];
+      attributes.disabled = (i == 0) ? 1 : 0;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      attributes.read_format = PERF_FORMAT_GROUP;
+      file_descriptors[i] = syscall(__NR_perf_event_open, &attributes, 0, -1, (i == 0) ? -1 : file_descriptors[0], 0);
+      if (file_descriptors[i] < 0)
+      {
+        static std::atomic<bool> warning_printed(false);
+        if (!warning_printed.exchange(true))
+        {
+          FINROC_LOG_PRINT_STATIC(WARNING, "Opening hardware performance counter '", cCOUNTER_NAMES[i], "' failed: ", strerror(errno), ". Check /proc/sys/kernel/perf_event_paranoid. Performance counters are not available.");
+        }
+        return;
+      }
+    }
+    ioctl(file_descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(file_descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    available = true;
+  }
+
+  ~tThreadCounters()
+  {
+    for (int file_descriptor : file_descriptors)
+    {
+      if (file_descriptor >= 0)
+      {
+        close(file_descriptor);
+      }
+    }
+  }
+
+  bool Read(tPerformanceCounters::tValues& values)
+  {
+    if (!available)
+    {
+      return false;
+    }
+    struct
+    {
+      uint64_t count;
+      uint64_t values[tPerformanceCounters::eDIMENSION];
+    } buffer;
+    if (read(file_descriptors[0], &buffer, sizeof(buffer)) != sizeof(buffer) || buffer.count != tPerformanceCounters::eDIMENSION)
+    {
+      return false;
+    }
+    std::copy(buffer.values, buffer.values + tPerformanceCounters::eDIMENSION, values.begin());
+    return true;
+  }
+
+private:
+
+  std::array<int, tPerformanceCounters::eDIMENSION> file_descriptors;
+  bool available;
+};
+
+#endif
+
+}
+
+const char* tPerformanceCounters::GetName(tCounter counter)
+{
+  return cCOUNTER_NAMES[counter];
+}
+
+bool tPerformanceCounters::IsEnabled()
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+bool tPerformanceCounters::Read(tValues& values)
+{
+#ifdef __linux__
+  static thread_local tThreadCounters thread_counters;
+  return thread_counters.Read(values);
+#else
+  return false;
+#endif
+}
+
+void tPerformanceCounters::SetEnabled(bool enable)
+{
+#ifndef __linux__
+  if (enable)
+  {
+    FINROC_LOG_PRINT_STATIC(WARNING, "Hardware performance counters are only available on Linux.");
+    return;
+  }
+#endif
+  enabled.store(enable, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
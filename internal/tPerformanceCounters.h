@@ -0,0 +1,127 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tPerformanceCounters.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tPerformanceCounters
+ *
+ * \b tPerformanceCounters
+ *
+ * Hardware performance counters of the calling thread
+ * (instructions, cycles, cache misses and branch misses).
+ * Uses perf_event_open() - and is therefore only available on Linux.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__tPerformanceCounters_h__
+#define __plugins__structure__internal__tPerformanceCounters_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Hardware performance counters of calling thread
+/*!
+ * Provides hardware performance counters of the calling thread.
+ * Counters are opened as one group on the first call to Read() in a thread -
+ * so that all values are obtained with a single system call.
+ * If counters are not available (e.g. not on Linux or due to perf_event_paranoid settings),
+ * a warning is printed once and Read() returns false.
+ */
+class tPerformanceCounters
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  enum tCounter
+  {
+    eINSTRUCTIONS,
+    eCYCLES,
+    eCACHE_MISSES,
+    eBRANCH_MISSES,
+    eDIMENSION
+  };
+
+  typedef std::array<uint64_t, eDIMENSION> tValues;
+
+  /*!
+   * \return Names of counters (e.g. for port names)
+   */
+  static const char* GetName(tCounter counter);
+
+  /*!
+   * \return Are performance counters enabled? (if so, profilers publish them)
+   */
+  static bool IsEnabled();
+
+  /*!
+   * Reads current counter values of calling thread
+   *
+   * \param values Object to write values to
+   * \return True if values could be read
+   */
+  static bool Read(tValues& values);
+
+  /*!
+   * \param enabled Whether performance counters should be enabled (should be set before modules are initialized)
+   */
+  static void SetEnabled(bool enabled);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
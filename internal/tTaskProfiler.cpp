@@ -0,0 +1,288 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tTaskProfiler.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tTaskProfiler.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Number of executions that statistics are computed over */
+static std::atomic<uint32_t> window_size(1000);
+
+/*! Overrun threshold of new profilers (in ns) */
+static std::atomic<uint64_t> default_overrun_threshold_ns(0);
+
+tTaskProfiler::tTaskProfiler(core::tPortGroup& profiling_port_group, const std::string& function_name) :
+  min_port(&profiling_port_group, function_name + " Min"),
+  max_port(&profiling_port_group, function_name + " Max"),
+  mean_port(&profiling_port_group, function_name + " Mean"),
+  p50_port(&profiling_port_group, function_name + " P50"),
+  p99_port(&profiling_port_group, function_name + " P99"),
+  p999_port(&profiling_port_group, function_name + " P99.9"),
+  overruns_port(&profiling_port_group, function_name + " Overruns"),
+  function_name(function_name),
+  module(*profiling_port_group.GetParent()),
+  allocation_counter(),
+  allocations_port(),
+  allocations(0),
+  performance_counters(),
+  current_window(0),
+  publishing(false),
+  publish_job(*this),
+  overruns(0),
+  overrun_threshold_ns(default_overrun_threshold_ns.load(std::memory_order_relaxed)),
+  start_time()
+{
+  ResetWindow(windows[0]);
+  ResetWindow(windows[1]);
+  min_port.Init();
+  max_port.Init();
+  mean_port.Init();
+  p50_port.Init();
+  p99_port.Init();
+  p999_port.Init();
+  overruns_port.Init();
+  if (tAllocationCounter::GetMode() != tAllocationDetectionMode::DISABLED)
+  {
+    allocation_counter.reset(new tAllocationCounter(tAllocationCounter::GetMode() == tAllocationDetectionMode::STRICT));
+    allocations_port = data_ports::tOutputPort<uint64_t>(&profiling_port_group, function_name + " Allocations");
+    allocations_port.Init();
+  }
+  if (tPerformanceCounters::IsEnabled())
+  {
+    performance_counters.reset(new tPerformanceCounterPorts());
+    performance_counters->valid = false;
+    for (size_t i = 0; i < tPerformanceCounters::eDIMENSION; i++)
+    {
+      auto& port = performance_counters->ports[i];
+      port = data_ports::tOutputPort<uint64_t>(&profiling_port_group, function_name + " " + tPerformanceCounters::GetName(static_cast<tPerformanceCounters::tCounter>(i)));
+      port.Init();
+    }
+  }
+  StartBackgroundWorker();
+}
+
+tTaskProfiler::~tTaskProfiler()
+{
+  WaitForPublication();
+}
+
+uint32_t tTaskProfiler::GetBucketIndex(uint64_t duration_ns)
+{
+  if (duration_ns < cSUB_BUCKETS)
+  {
+    return static_cast<uint32_t>(duration_ns);
+  }
+  uint32_t exponent = 63 - __builtin_clzll(duration_ns);
+  uint32_t sub_bucket = (duration_ns >> (exponent - cSUB_BUCKET_BITS)) & (cSUB_BUCKETS - 1);
+  return (exponent - cSUB_BUCKET_BITS + 1) * cSUB_BUCKETS + sub_bucket;
+}
+
+uint64_t tTaskProfiler::GetBucketUpperBound(uint32_t bucket_index)
+{
+  if (bucket_index < cSUB_BUCKETS)
+  {
+    return bucket_index;
+  }
+  uint32_t exponent = bucket_index / cSUB_BUCKETS + cSUB_BUCKET_BITS - 1;
+  uint64_t sub_bucket = bucket_index % cSUB_BUCKETS;
+  uint64_t lower_bound = (cSUB_BUCKETS + sub_bucket) << (exponent - cSUB_BUCKET_BITS);
+  return lower_bound + ((static_cast<uint64_t>(1) << (exponent - cSUB_BUCKET_BITS)) - 1);
+}
+
+uint64_t tTaskProfiler::GetPercentile(const tWindow& window, double percentile)
+{
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile * window.count)));
+  uint64_t accumulated = 0;
+  for (uint32_t i = 0; i < cBUCKET_COUNT; i++)
+  {
+    accumulated += window.buckets[i];
+    if (accumulated >= rank)
+    {
+      return std::min(GetBucketUpperBound(i), window.max_ns);
+    }
+  }
+  return window.max_ns;
+}
+
+uint32_t tTaskProfiler::GetWindowSize()
+{
+  return window_size.load(std::memory_order_relaxed);
+}
+
+void tTaskProfiler::PublishStatistics(const tWindow& window)
+{
+  if (window.count)
+  {
+    min_port.Publish(std::chrono::nanoseconds(window.min_ns));
+    max_port.Publish(std::chrono::nanoseconds(window.max_ns));
+    mean_port.Publish(std::chrono::nanoseconds(window.sum_ns / window.count));
+    p50_port.Publish(std::chrono::nanoseconds(GetPercentile(window, 0.5)));
+    p99_port.Publish(std::chrono::nanoseconds(GetPercentile(window, 0.99)));
+    p999_port.Publish(std::chrono::nanoseconds(GetPercentile(window, 0.999)));
+  }
+  overruns_port.Publish(window.overruns);
+  if (allocation_counter)
+  {
+    allocations_port.Publish(window.allocations);
+  }
+  if (performance_counters && window.counter_samples)
+  {
+    for (size_t i = 0; i < tPerformanceCounters::eDIMENSION; i++)
+    {
+      performance_counters->ports[i].Publish(window.counter_sums[i] / window.counter_samples);
+    }
+  }
+}
+
+void tTaskProfiler::ResetWindow(tWindow& window)
+{
+  std::fill(std::begin(window.buckets), std::end(window.buckets), 0);
+  window.count = 0;
+  window.sum_ns = 0;
+  window.min_ns = std::numeric_limits<uint64_t>::max();
+  window.max_ns = 0;
+  window.counter_sums.fill(0);
+  window.counter_samples = 0;
+  window.overruns = 0;
+  window.allocations = 0;
+}
+
+void tTaskProfiler::SetDefaultOverrunThreshold(rrlib::time::tDuration threshold)
+{
+  default_overrun_threshold_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(threshold).count(), std::memory_order_relaxed);
+}
+
+void tTaskProfiler::SetWindowSize(uint32_t new_window_size)
+{
+  window_size.store(std::max<uint32_t>(1, new_window_size), std::memory_order_relaxed);
+}
+
+void tTaskProfiler::Stop()
+{
+  uint64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count();
+  tWindow& window = windows[current_window];
+  if (performance_counters && performance_counters->valid && tPerformanceCounters::Read(performance_counters->end_values))
+  {
+    for (size_t i = 0; i < tPerformanceCounters::eDIMENSION; i++)
+    {
+      window.counter_sums[i] += performance_counters->end_values[i] - performance_counters->start_values[i];
+    }
+    window.counter_samples++;
+  }
+
+  window.buckets[GetBucketIndex(duration_ns)]++;
+  window.sum_ns += duration_ns;
+  window.min_ns = std::min(window.min_ns, duration_ns);
+  window.max_ns = std::max(window.max_ns, duration_ns);
+  uint64_t threshold = overrun_threshold_ns.load(std::memory_order_relaxed);
+  if (threshold && duration_ns > threshold)
+  {
+    overruns++;
+  }
+  window.count++;
+  if (window.count >= window_size.load(std::memory_order_relaxed) && (!publishing.load(std::memory_order_acquire)))
+  {
+    // Hand complete window to background worker - and continue with the other (cleared) window
+    window.overruns = overruns;
+    window.allocations = allocations;
+    current_window = 1 - current_window;
+    publishing.store(true, std::memory_order_release);
+    ExecuteInBackground(publish_job);
+  }
+
+  if (allocation_counter && allocation_counter->HasBacktrace())
+  {
+    allocation_counter->LogBacktrace(function_name + " of module '" + module.GetQualifiedName() + "'");
+  }
+}
+
+void tTaskProfiler::tPublishJob::Execute()
+{
+  tWindow& window = profiler.windows[1 - profiler.current_window]; // current_window is not changed while publishing is set
+  profiler.PublishStatistics(window);
+  ResetWindow(window);
+  profiler.publishing.store(false, std::memory_order_release);
+}
+
+void tTaskProfiler::WaitForPublication()
+{
+  while (publishing.load(std::memory_order_acquire))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,327 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tTaskProfiler.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tTaskProfiler
+ *
+ * \b tTaskProfiler
+ *
+ * Profiles executions of a module's cycle function (Update(), Sense() or Control())
+ * and publishes statistics of consecutive windows via the module's profiling ports.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__tTaskProfiler_h__
+#define __plugins__structure__internal__tTaskProfiler_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include "core/port/tPortGroup.h"
+#include "plugins/data_ports/tOutputPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/background_worker.h"
+#include "plugins/structure/internal/tAllocationCounter.h"
+#include "plugins/structure/internal/tPerformanceCounters.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Profiles executions of a module's cycle function
+/*!
+ * Measures the duration of each execution of a module's cycle function (e.g. Update()).
+ * Durations are recorded in a histogram with fixed, logarithmically spaced buckets
+ * (8 buckets per power of two - so percentiles have a relative error below 12.5%).
+ * Recording a duration only updates a few counters of the current window.
+ *
+ * Statistics are computed over consecutive windows of executions (see SetWindowSize()) - not over
+ * a rolling window, which would require storing every duration of the window.
+ * When a window is complete, the executing thread only switches to the second window
+ * and hands the complete one to the background worker (see background_worker.h).
+ * The background worker computes minimum, maximum, mean and the 50th, 99th and 99.9th percentile,
+ * publishes them via ports in the module's profiling port group - together with the total number of overruns
+ * (executions longer than the overrun threshold) - and clears the window.
+ * If the background worker has not finished publishing the previous window yet, the current window is extended.
+ *
+ * If hardware performance counters are enabled (see tPerformanceCounters), the mean counter values
+ * per execution are published with the statistics of each window.
+ * If allocation detection is enabled (see tAllocationCounter), heap allocations in tAllocationScope
+ * are counted (total is published with the statistics); in strict mode, a backtrace of the first
+ * allocation is logged.
+ *
+ * Start() and Stop() must be called by the thread executing the task.
+ */
+class tTaskProfiler
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Profiles an execution (from construction to destruction) - if profiler is not nullptr */
+  class tScope
+  {
+  public:
+    tScope(tTaskProfiler* profiler) : profiler(profiler)
+    {
+      if (profiler)
+      {
+        profiler->Start();
+      }
+    }
+
+    ~tScope()
+    {
+      if (profiler)
+      {
+        profiler->Stop();
+      }
+    }
+
+  private:
+    tTaskProfiler* profiler;
+  };
+
+  /*!
+   * Counts heap allocations (from construction to destruction) - if profiler is not nullptr and allocation detection is enabled.
+   * Should only enclose the call of the cycle function itself (not framework code such as parameter or changed flag processing).
+   * Must be nested in a tScope.
+   */
+  class tAllocationScope
+  {
+  public:
+    tAllocationScope(tTaskProfiler* profiler) : profiler(profiler && profiler->allocation_counter ? profiler : nullptr)
+    {
+      if (this->profiler)
+      {
+        this->profiler->allocation_counter->Start();
+      }
+    }
+
+    ~tAllocationScope()
+    {
+      if (profiler)
+      {
+        profiler->allocations += profiler->allocation_counter->Stop();
+      }
+    }
+
+  private:
+    tTaskProfiler* profiler;
+  };
+
+  /*!
+   * Creates profiling ports for cycle function
+   *
+   * \param profiling_port_group Module's profiling port group
+   * \param function_name Name of profiled function (e.g. "Update()") - used as prefix of port names
+   */
+  tTaskProfiler(core::tPortGroup& profiling_port_group, const std::string& function_name);
+
+  /*! Waits until statistics have been published */
+  ~tTaskProfiler();
+
+  /*!
+   * \return Number of executions that statistics are computed over - applies to all profilers
+   */
+  static uint32_t GetWindowSize();
+
+  /*!
+   * \param window_size Number of executions that statistics are computed over - applies to all profilers (default: 1000)
+   */
+  static void SetWindowSize(uint32_t window_size);
+
+  /*!
+   * \param threshold Default overrun threshold for profilers created afterwards (zero disables overrun counting - default)
+   */
+  static void SetDefaultOverrunThreshold(rrlib::time::tDuration threshold);
+
+  /*!
+   * \param threshold Executions taking longer are counted as overruns (zero disables overrun counting)
+   */
+  void SetOverrunThreshold(rrlib::time::tDuration threshold)
+  {
+    overrun_threshold_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(threshold).count();
+  }
+
+  /*!
+   * Marks start of an execution
+   */
+  void Start()
+  {
+    if (performance_counters)
+    {
+      performance_counters->valid = tPerformanceCounters::Read(performance_counters->start_values);
+    }
+    start_time = std::chrono::steady_clock::now();
+  }
+
+  /*!
+   * Marks end of an execution
+   * (hands window to background worker for publishing if it is complete)
+   */
+  void Stop();
+
+  /*!
+   * Waits until background worker has published the last complete window.
+   * Must be called before the profiling ports are deleted (e.g. in PrepareDelete() of module).
+   */
+  void WaitForPublication();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cSUB_BUCKET_BITS = 3 };
+  enum { cSUB_BUCKETS = 1 << cSUB_BUCKET_BITS };
+  enum { cBUCKET_COUNT = (64 - cSUB_BUCKET_BITS + 1) * cSUB_BUCKETS };
+
+  /*! Ports that statistics are published via */
+  data_ports::tOutputPort<rrlib::time::tDuration> min_port, max_port, mean_port, p50_port, p99_port, p999_port;
+  data_ports::tOutputPort<uint64_t> overruns_port;
+
+  /*! Name of profiled function (e.g. "Update()") */
+  std::string function_name;
+
+  /*! Module whose function is profiled */
+  core::tFrameworkElement& module;
+
+  /*! Counts heap allocations during executions (only created if allocation detection is enabled) */
+  std::unique_ptr<tAllocationCounter> allocation_counter;
+
+  /*! Port that total number of heap allocations is published via (only created if allocation detection is enabled) */
+  data_ports::tOutputPort<uint64_t> allocations_port;
+
+  /*! Total number of heap allocations during executions */
+  uint64_t allocations;
+
+  /*! Hardware performance counter values and ports */
+  struct tPerformanceCounterPorts
+  {
+    std::array<data_ports::tOutputPort<uint64_t>, tPerformanceCounters::eDIMENSION> ports;
+    tPerformanceCounters::tValues start_values, end_values;
+    bool valid;
+  };
+
+  /*! Hardware performance counter values and ports (only created if performance counters are enabled) */
+  std::unique_ptr<tPerformanceCounterPorts> performance_counters;
+
+  /*! Statistics of a window */
+  struct tWindow
+  {
+    /*! Histogram of durations */
+    uint32_t buckets[cBUCKET_COUNT];
+
+    /*! Number of executions, sum of durations, minimum and maximum duration (in ns) */
+    uint32_t count;
+    uint64_t sum_ns, min_ns, max_ns;
+
+    /*! Sums of performance counter values and number of executions they were read in */
+    tPerformanceCounters::tValues counter_sums;
+    uint32_t counter_samples;
+
+    /*! Total number of overruns and heap allocations when window was completed */
+    uint64_t overruns, allocations;
+  };
+
+  /*! Job that publishes a complete window */
+  class tPublishJob : public tBackgroundJob
+  {
+  public:
+    tPublishJob(tTaskProfiler& profiler) : profiler(profiler) {}
+    virtual void Execute() override;
+  private:
+    tTaskProfiler& profiler;
+  };
+
+  /*! Windows: one is written by the executing thread - the other one is published or cleared (while publishing is true) */
+  tWindow windows[2];
+
+  /*! Index of window written by the executing thread */
+  uint32_t current_window;
+
+  /*! Is the other window being published? (set by executing thread - reset by background worker) */
+  std::atomic<bool> publishing;
+
+  /*! Job that publishes a complete window */
+  tPublishJob publish_job;
+
+  /*! Total number of overruns */
+  uint64_t overruns;
+
+  /*! Overrun threshold in ns (0 if disabled) */
+  std::atomic<uint64_t> overrun_threshold_ns;
+
+  /*! Start of current execution */
+  std::chrono::steady_clock::time_point start_time;
+
+  /*! \return Index of bucket for specified duration */
+  static uint32_t GetBucketIndex(uint64_t duration_ns);
+
+  /*! \return Largest duration in bucket with specified index */
+  static uint64_t GetBucketUpperBound(uint32_t bucket_index);
+
+  /*! \return Percentile of durations in specified window (upper bound of bucket - limited to maximum) */
+  static uint64_t GetPercentile(const tWindow& window, double percentile);
+
+  /*! Publishes statistics of specified window (called by background worker) */
+  void PublishStatistics(const tWindow& window);
+
+  /*! Clears specified window */
+  static void ResetWindow(tWindow& window);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
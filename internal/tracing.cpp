@@ -0,0 +1,421 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tracing.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/structure/internal/tracing.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "rrlib/logging/messages.h"
+#include "core/tFrameworkElement.h"
+#include "plugins/scheduling/tExecutionControl.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Identifies trace files (see WriteTrace()) */
+static const char cTRACE_MAGIC[8] = { 'F', 'R', 'T', 'R', 'A', 'C', 'E', 'S' };
+static const uint32_t cTRACE_VERSION = 1;
+
+/*! Number of events in each thread container's ring buffer (oldest events are overwritten) */
+static const size_t cRING_BUFFER_SIZE = 1 << 16;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+enum tEventType : uint32_t
+{
+  eTASK_BEGIN,
+  eTASK_END,
+  eCYCLE
+};
+
+struct tEvent
+{
+  uint64_t timestamp_ns;
+  uint32_t task_id;
+  uint32_t type;
+};
+
+/*! Ring buffer of one thread container (only written by the thread executing the container's tasks) */
+struct tTraceBuffer
+{
+  /*! Name of buffer (qualified name of thread container) */
+  std::string name;
+
+  /*! Events */
+  std::unique_ptr<tEvent[]> events;
+
+  /*! Total number of events written (index of next event is written % cRING_BUFFER_SIZE) */
+  std::atomic<uint64_t> written;
+
+  /*! Id of first task executed by the thread container (starting it again marks a new cycle) */
+  uint32_t first_task_id;
+};
+
+namespace
+{
+
+/*!
+ * Layout of trace files:
+ *
+ * tTraceHeader
+ * task names[task_count]    (uint32_t length + characters; task id i has index i - 1)
+ * threads[thread_count]     (uint32_t name length + characters, uint32_t event count, tEvent[event count] - oldest first)
+ *
+ * Integers are stored in the native byte order.
+ */
+struct tTraceHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t task_count;
+  uint32_t thread_count;
+};
+
+struct tTracingState
+{
+  /*! Is tracing enabled? */
+  std::atomic<bool> enabled;
+
+  /*! Mutex for task names and trace buffers */
+  std::mutex mutex;
+
+  /*! Names of traced tasks (task id i has index i - 1) */
+  std::vector<std::string> task_names;
+
+  /*! Ring buffers of all thread containers with traced tasks (kept when thread containers are deleted - and reused by containers with the same name) */
+  std::vector<std::unique_ptr<tTraceBuffer>> trace_buffers;
+
+  tTracingState() : enabled(false), mutex(), task_names(), trace_buffers()
+  {}
+};
+
+tTracingState& GetState()
+{
+  // Never deleted, as threads might record events until the very end
+  static tTracingState* state = new tTracingState();
+  return *state;
+}
+
+void RecordEvent(tTraceBuffer& buffer, uint32_t task_id, tEventType type)
+{
+  uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  tEvent& event = buffer.events[index % cRING_BUFFER_SIZE];
+  event.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  event.task_id = task_id;
+  event.type = type;
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void WriteString(std::ofstream& stream, const std::string& string)
+{
+  uint32_t length = string.length();
+  stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  stream.write(string.c_str(), length);
+}
+
+bool ReadString(std::ifstream& stream, std::string& string)
+{
+  uint32_t length = 0;
+  if (!stream.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > (1 << 20))
+  {
+    return false;
+  }
+  string.resize(length);
+  return length == 0 || stream.read(&string[0], length);
+}
+
+void WriteJsonString(std::ofstream& stream, const std::string& string)
+{
+  stream << '"';
+  for (char c : string)
+  {
+    if (c == '"' || c == '\\')
+    {
+      stream << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+      stream << escaped;
+    }
+    else
+    {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
+
+}
+
+bool ConvertTraceToChromeJson(const std::string& trace_file, const std::string& json_file)
+{
+  std::ifstream input(trace_file, std::ios::binary);
+  tTraceHeader header;
+  if (!(input && input.read(reinterpret_cast<char*>(&header), sizeof(header)) && memcmp(header.magic, cTRACE_MAGIC, sizeof(cTRACE_MAGIC)) == 0 && header.version == cTRACE_VERSION))
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "'", trace_file, "' is not a valid trace file.");
+    return false;
+  }
+
+  std::vector<std::string> task_names(header.task_count);
+  for (std::string & name : task_names)
+  {
+    if (!ReadString(input, name))
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Trace file '", trace_file, "' is truncated.");
+      return false;
+    }
+  }
+  std::vector<std::string> thread_names(header.thread_count);
+  std::vector<std::vector<tEvent>> thread_events(header.thread_count);
+  uint64_t start_time = std::numeric_limits<uint64_t>::max();
+  for (uint32_t i = 0; i < header.thread_count; i++)
+  {
+    uint32_t event_count = 0;
+    if (!(ReadString(input, thread_names[i]) && input.read(reinterpret_cast<char*>(&event_count), sizeof(event_count)) && event_count <= cRING_BUFFER_SIZE))
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Trace file '", trace_file, "' is truncated.");
+      return false;
+    }
+    thread_events[i].resize(event_count);
+    if (event_count && (!input.read(reinterpret_cast<char*>(thread_events[i].data()), event_count * sizeof(tEvent))))
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Trace file '", trace_file, "' is truncated.");
+      return false;
+    }
+    if (event_count)
+    {
+      start_time = std::min(start_time, thread_events[i].front().timestamp_ns);
+    }
+  }
+
+  std::ofstream output(json_file);
+  if (!output)
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "Could not open '", json_file, "' for writing.");
+    return false;
+  }
+  output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first_event = true;
+  char timestamp[32];
+  for (uint32_t i = 0; i < header.thread_count; i++)
+  {
+    output << (first_event ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (i + 1) << ",\"args\":{\"name\":";
+    WriteJsonString(output, thread_names[i]);
+    output << "}}";
+    first_event = false;
+
+    int depth = 0;
+    for (const tEvent & event : thread_events[i])
+    {
+      if (event.type == eTASK_END && depth == 0)
+      {
+        continue; // begin was overwritten in ring buffer
+      }
+      if ((event.type == eTASK_BEGIN || event.type == eTASK_END) && (event.task_id == 0 || event.task_id > task_names.size()))
+      {
+        continue;
+      }
+      snprintf(timestamp, sizeof(timestamp), "%.3f", (event.timestamp_ns - start_time) / 1000.0);
+      output << ",\n{\"ph\":\"" << (event.type == eTASK_BEGIN ? "B" : (event.type == eTASK_END ? "E" : "i")) << "\",\"pid\":1,\"tid\":" << (i + 1) << ",\"ts\":" << timestamp << ",\"name\":";
+      if (event.type == eCYCLE)
+      {
+        output << "\"Cycle\",\"s\":\"t\"}";
+        continue;
+      }
+      WriteJsonString(output, task_names[event.task_id - 1]);
+      output << "}";
+      depth += (event.type == eTASK_BEGIN) ? 1 : -1;
+    }
+  }
+  output << "\n]}\n";
+  if (!output)
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "Error writing '", json_file, "'.");
+    return false;
+  }
+  return true;
+}
+
+void EnableTracing()
+{
+  GetState().enabled.store(true, std::memory_order_relaxed);
+}
+
+bool IsTracingEnabled()
+{
+  return GetState().enabled.load(std::memory_order_relaxed);
+}
+
+void RecordTaskBegin(const tTracedTask& task)
+{
+  tTraceBuffer& buffer = *task.buffer;
+  if (!buffer.first_task_id)
+  {
+    buffer.first_task_id = task.id;
+  }
+  else if (buffer.first_task_id == task.id)
+  {
+    RecordEvent(buffer, 0, eCYCLE);
+  }
+  RecordEvent(buffer, task.id, eTASK_BEGIN);
+}
+
+void RecordTaskEnd(const tTracedTask& task)
+{
+  RecordEvent(*task.buffer, task.id, eTASK_END);
+}
+
+tTracedTask RegisterTracedTask(const std::string& name, core::tFrameworkElement& element)
+{
+  tTracedTask result = { 0, nullptr };
+  tTracingState& state = GetState();
+  if (!state.enabled.load(std::memory_order_relaxed))
+  {
+    return result;
+  }
+
+  // Thread container executing task
+  core::tFrameworkElement* container = &element;
+  while (container && (!container->GetAnnotation<scheduling::tExecutionControl>()))
+  {
+    container = container->GetParent();
+  }
+  std::string buffer_name = container ? container->GetQualifiedName() : "(no thread container)";
+
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.task_names.push_back(name);
+  result.id = state.task_names.size();
+  for (auto & buffer : state.trace_buffers)
+  {
+    if (buffer->name == buffer_name)
+    {
+      result.buffer = buffer.get();
+      return result;
+    }
+  }
+  std::unique_ptr<tTraceBuffer> buffer(new tTraceBuffer());
+  buffer->name = buffer_name;
+  buffer->events.reset(new tEvent[cRING_BUFFER_SIZE]);
+  buffer->written.store(0, std::memory_order_relaxed);
+  buffer->first_task_id = 0;
+  result.buffer = buffer.get();
+  state.trace_buffers.push_back(std::move(buffer));
+  return result;
+}
+
+bool WriteTrace(const std::string& file)
+{
+  tTracingState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  std::ofstream output(file, std::ios::binary);
+  if (!output)
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "Could not open '", file, "' for writing trace.");
+    return false;
+  }
+
+  tTraceHeader header;
+  memcpy(header.magic, cTRACE_MAGIC, sizeof(cTRACE_MAGIC));
+  header.version = cTRACE_VERSION;
+  header.task_count = state.task_names.size();
+  header.thread_count = state.trace_buffers.size();
+  output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const std::string & name : state.task_names)
+  {
+    WriteString(output, name);
+  }
+  for (const auto & buffer : state.trace_buffers)
+  {
+    uint64_t written = buffer->written.load(std::memory_order_acquire);
+    uint32_t event_count = std::min<uint64_t>(written, cRING_BUFFER_SIZE);
+    WriteString(output, buffer->name);
+    output.write(reinterpret_cast<const char*>(&event_count), sizeof(event_count));
+    for (uint64_t i = written - event_count; i < written; i++)
+    {
+      output.write(reinterpret_cast<const char*>(&buffer->events[i % cRING_BUFFER_SIZE]), sizeof(tEvent));
+    }
+  }
+  if (!output)
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "Error writing trace to '", file, "'.");
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,183 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/internal/tracing.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief
+ *
+ * Internal helper functions:
+ * Records begin and end of module task executions (Update(), Sense(), Control())
+ * in one ring buffer per thread container - in order to analyze the interleaving of modules across thread containers.
+ *
+ * Ring buffers are allocated when the first task of a thread container is registered.
+ * Each buffer is only written by the thread executing the container's tasks - so recording an event
+ * requires no allocation or locking (only a timestamp and a few stores). When a container starts
+ * the first task it ever executed again, a cycle boundary is recorded (as thread containers execute
+ * their tasks in the same order every cycle).
+ *
+ * Traces are written to compact binary files that can be converted to Chrome trace JSON
+ * (viewable with chrome://tracing or Perfetto) - e.g. with the trace_to_json tool.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__internal__tracing_h__
+#define __plugins__structure__internal__tracing_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace core
+{
+class tFrameworkElement;
+}
+
+namespace structure
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+struct tTraceBuffer;
+
+/*! Traced task (see RegisterTracedTask()) */
+struct tTracedTask
+{
+  /*! Task id (zero if task is not traced) */
+  uint32_t id;
+
+  /*! Ring buffer that task's events are recorded in */
+  tTraceBuffer* buffer;
+};
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * Converts binary trace file to Chrome trace JSON
+ *
+ * \param trace_file Binary trace file (see WriteTrace())
+ * \param json_file JSON file to write
+ * \return True if conversion succeeded (otherwise error is logged)
+ */
+bool ConvertTraceToChromeJson(const std::string& trace_file, const std::string& json_file);
+
+/*!
+ * Enables tracing
+ * (should be called before modules are initialized, as tasks are only traced if tracing was enabled when they were registered)
+ */
+void EnableTracing();
+
+/*!
+ * \return Is tracing enabled?
+ */
+bool IsTracingEnabled();
+
+/*!
+ * (Should only be called by tTraceScope)
+ *
+ * Records begin of task execution
+ *
+ * \param task Traced task (see RegisterTracedTask())
+ */
+void RecordTaskBegin(const tTracedTask& task);
+
+/*!
+ * (Should only be called by tTraceScope)
+ *
+ * Records end of task execution
+ *
+ * \param task Traced task (see RegisterTracedTask())
+ */
+void RecordTaskEnd(const tTracedTask& task);
+
+/*!
+ * Registers task to trace
+ * (allocates ring buffer of the thread container executing the task - if it has none yet)
+ *
+ * \param name Name of task in trace (e.g. qualified name of module and function)
+ * \param element Framework element (e.g. module) whose task is traced
+ * \return Traced task (with zero id if tracing is not enabled)
+ */
+tTracedTask RegisterTracedTask(const std::string& name, core::tFrameworkElement& element);
+
+/*!
+ * Writes binary trace file with events currently in the ring buffers of all thread containers
+ * (may be called at any time; ideally, no tasks are executed while writing)
+ *
+ * \param file File to write
+ * \return True if file was written successfully (otherwise error is logged)
+ */
+bool WriteTrace(const std::string& file);
+
+/*!
+ * Records begin and end of task execution (constructor and destructor) -
+ * if task is traced
+ */
+class tTraceScope
+{
+public:
+  explicit tTraceScope(const tTracedTask& task) : task(task)
+  {
+    if (task.id)
+    {
+      RecordTaskBegin(task);
+    }
+  }
+
+  ~tTraceScope()
+  {
+    if (task.id)
+    {
+      RecordTaskEnd(task);
+    }
+  }
+
+private:
+  const tTracedTask& task;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
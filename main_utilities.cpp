@@ -67,6 +67,11 @@ extern "C"
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/structure/tComponent.h"
+#include "plugins/structure/internal/register.h"
+#include "plugins/structure/internal/tAllocationCounter.h"
+#include "plugins/structure/internal/tPerformanceCounters.h"
+#include "plugins/structure/internal/tTaskProfiler.h"
+#include "plugins/structure/internal/tracing.h"
 
 extern bool make_all_port_links_unique;
 
@@ -109,6 +114,7 @@ bool enable_crash_handler = false;
 #else
 bool enable_crash_handler = true;
 #endif
+std::string trace_file; // Trace file to write on shutdown (empty if tracing is disabled)
 
 // We do not use stuff from rrlib_thread, because we have the rare case that in signal handler
 // waiting thread does something else, which is problematic with respect to enforcing lock order
@@ -287,6 +293,78 @@ bool OptionsHandler(const rrlib::getopt::tNameToOptionMap &name_to_option_map)
   if (profiling->IsActive())
   {
     scheduling::SetProfilingEnabled(true);
+    internal::SetRegisterStatisticsEnabled(true);
+  }
+
+  // perf-counters
+  rrlib::getopt::tOption perf_counters(name_to_option_map.at("perf-counters"));
+  if (perf_counters->IsActive())
+  {
+    scheduling::SetProfilingEnabled(true);
+    internal::tPerformanceCounters::SetEnabled(true);
+  }
+
+  // allocation-detection
+  rrlib::getopt::tOption allocation_detection(name_to_option_map.at("allocation-detection"));
+  if (allocation_detection->IsActive())
+  {
+    std::string s(rrlib::getopt::EvaluateValue(allocation_detection));
+    if (s.compare("on") == 0)
+    {
+      internal::tAllocationCounter::SetMode(internal::tAllocationDetectionMode::COUNT);
+    }
+    else if (s.compare("strict") == 0)
+    {
+      internal::tAllocationCounter::SetMode(internal::tAllocationDetectionMode::STRICT);
+    }
+    else
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Option --allocation-detection needs be either 'on' or 'strict' (not '", s, "').");
+      return false;
+    }
+    if (!internal::tAllocationCounter::HooksInstalled())
+    {
+      FINROC_LOG_PRINT_STATIC(WARNING, "Allocation detection requires the malloc hooks in library finroc_plugins_structure_allocation_detection. Link it to the program or load it with LD_PRELOAD. No allocations will be detected.");
+    }
+    scheduling::SetProfilingEnabled(true);
+  }
+
+  // trace
+  rrlib::getopt::tOption trace(name_to_option_map.at("trace"));
+  if (trace->IsActive())
+  {
+    trace_file = rrlib::getopt::EvaluateValue(trace);
+    internal::EnableTracing();
+  }
+
+  // profiling-window
+  rrlib::getopt::tOption profiling_window(name_to_option_map.at("profiling-window"));
+  if (profiling_window->IsActive())
+  {
+    int window_size = atoi(rrlib::getopt::EvaluateValue(profiling_window).c_str());
+    if (window_size < 1)
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Invalid profiling window '", window_size, "'. Using default: ", internal::tTaskProfiler::GetWindowSize());
+    }
+    else
+    {
+      internal::tTaskProfiler::SetWindowSize(window_size);
+    }
+  }
+
+  // profiling-overrun-threshold
+  rrlib::getopt::tOption profiling_overrun_threshold(name_to_option_map.at("profiling-overrun-threshold"));
+  if (profiling_overrun_threshold->IsActive())
+  {
+    int threshold = atoi(rrlib::getopt::EvaluateValue(profiling_overrun_threshold).c_str());
+    if (threshold < 0)
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Invalid profiling overrun threshold '", threshold, "'. Overruns are not counted.");
+    }
+    else
+    {
+      internal::tTaskProfiler::SetDefaultOverrunThreshold(std::chrono::microseconds(threshold));
+    }
   }
 
   // component visualization
@@ -347,6 +425,11 @@ void RegisterCommonOptions()
   rrlib::getopt::AddFlag("pause", 0, "Pause program at startup", &OptionsHandler);
   rrlib::getopt::AddFlag("port-links-are-not-unique", 0, "Port links in this part are not unique in P2P network (=> host name is prepended in GUI, for instance).", &OptionsHandler);
   rrlib::getopt::AddFlag("profiling", 0, "Enables profiling (creates additional ports with profiling information)", &OptionsHandler);
+  rrlib::getopt::AddFlag("perf-counters", 0, "Enables profiling with hardware performance counters per Update()/Sense()/Control() call (Linux only; implies --profiling)", &OptionsHandler);
+  rrlib::getopt::AddValue("allocation-detection", 0, "Counts heap allocations in Update()/Sense()/Control() calls: 'on' or 'strict' (additionally logs backtrace of first allocation per module and function; implies --profiling; requires allocation_detection library)", &OptionsHandler);
+  rrlib::getopt::AddValue("trace", 0, "Records execution of Update()/Sense()/Control() calls and writes binary trace to specified file on shutdown (convert to Chrome trace JSON with trace_to_json)", &OptionsHandler);
+  rrlib::getopt::AddValue("profiling-window", 0, "Number of Update()/Sense()/Control() calls that profiling statistics are computed over (default: 1000)", &OptionsHandler);
+  rrlib::getopt::AddValue("profiling-overrun-threshold", 0, "Update()/Sense()/Control() calls taking longer (in microseconds) are counted as overruns in profiling statistics", &OptionsHandler);
   rrlib::getopt::AddFlag("disable-component-visualization", 0, "Disables component visualization (no dedicated visualization ports will be created)", &OptionsHandler);
 }
 
@@ -416,6 +499,15 @@ int InitializeAndRunMainLoop(const std::string &program_name)
     }
   }
 
+  if (scheduling::IsProfilingEnabled())
+  {
+    internal::tRegisterStatistics statistics = internal::GetRegisterStatistics();
+    FINROC_LOG_PRINT_STATIC(USER, "Component register statistics after initialization: ", statistics.parent_lookups, " parent lookups (",
+                            statistics.thread_local_hits, " without locking, ", statistics.parent_lookups_per_second, "/s, scan length avg. ", statistics.average_scan_length,
+                            " max. ", statistics.max_scan_length, "), ", statistics.port_name_lookups, " port name lookups (", statistics.port_name_type_resolutions,
+                            " type resolutions), mutex wait time ", std::chrono::duration<double, std::milli>(statistics.mutex_wait_time).count(), " ms, ", statistics.live_memory_blocks, " live memory blocks");
+  }
+
 #ifdef _LIB_FINROC_PLUGINS_TCP_PRESENT_
   if (tcp_peer->IsReady())
   {
@@ -462,6 +554,11 @@ int InitializeAndRunMainLoop(const std::string &program_name)
   // However, doing this before static deinitialization can avoid issues with external libraries and thread container threads still running.
   core::tRuntimeEnvironment::Shutdown();
 
+  if (trace_file.length() && internal::WriteTrace(trace_file))
+  {
+    FINROC_LOG_PRINT_STATIC(USER, "Trace written to '", trace_file, "'.");
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -38,6 +38,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/structure/tLazyPort.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -73,20 +74,22 @@ core::tFrameworkElement::tFlag tComponent::cDO_NOT_CREATE_NOW = core::tFramework
 tComponent::tComponent(core::tFrameworkElement *parent, const std::string &name, tFlags extra_flags) :
   tFrameworkElement(parent, name, extra_flags),
   parameters(nullptr),
+  memory_block(internal::AddModule(this)),
   auto_name_port_count(0),
   count_for_type(nullptr)
 {
-  internal::AddModule(this);
-  if (!internal::FindParent(this, false))
+  if (!memory_block.IsValid())
   {
     FINROC_LOG_PRINT(ERROR, "Component ", GetQualifiedName(), " was not created using new().");
     abort();
   }
+  internal::OpenPortConstructionBatch(this, memory_block);
 }
 
 tComponent::~tComponent()
 {
-  internal::RemoveModule(this);
+  internal::ClosePortConstructionBatch(this);
+  internal::RemoveModule(memory_block);
 }
 
 void tComponent::CheckStaticParameters()
@@ -94,6 +97,26 @@ void tComponent::CheckStaticParameters()
   parameters::internal::tStaticParameterList::DoStaticParameterEvaluation(*this);
 }
 
+void tComponent::PostChildInit()
+{
+  // All member ports have been constructed now
+  internal::ClosePortConstructionBatch(this);
+  internal::RetireMemoryBlock(memory_block);
+}
+
+bool tComponent::MaterializeLazyPort(const std::string& name)
+{
+  for (internal::tLazyPortBase * lazy_port : lazy_ports)
+  {
+    if (lazy_port->GetName() == name)
+    {
+      lazy_port->MaterializePort();
+      return true;
+    }
+  }
+  return false;
+}
+
 core::tFrameworkElement& tComponent::GetParameterParent()
 {
   if (!parameters)
@@ -62,6 +62,13 @@ namespace structure
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+template <typename TPort>
+class tLazyPort;
+
+namespace internal
+{
+class tLazyPortBase;
+}
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -135,6 +142,16 @@ public:
     return parameters::tConfigFile::Find(*this);
   }
 
+  /*!
+   * Creates the real port of a lazy port (see tLazyPort.h) - e.g. in order to connect it.
+   * Has no effect if port has already been created.
+   * (Connectors to the lazy port's path - e.g. from config files - create the port automatically)
+   *
+   * \param name Name of lazy port
+   * \return True if component has a lazy port with the specified name
+   */
+  bool MaterializeLazyPort(const std::string& name);
+
   /*!
    * Components may have a std::vector of ports in their interfaces.
    * This is a convenience method for adjusting the number of ports in such vectors.
@@ -148,6 +165,8 @@ public:
    * \param common_prefix Common prefix of all ports names (see port naming above; add a pending space if you like to have a space between prefix and space)
    * \param start_index Number in name of first port in vector (incremented for each further port)
    * \param start_index Common postfix of all ports names (see port naming above; could be e.g. ']')
+   *
+   * (for ports that are stored contiguously and can be used as plain component members, see tPortArray.h)
    */
   template <typename TPort>
   void ResizePortVector(std::vector<TPort>& port_vector, int number_of_ports, const std::string& common_prefix, size_t start_index = 1, const std::string& common_postfix = "")
@@ -160,9 +179,7 @@ public:
     while (port_vector.size() < number_of_ports)
     {
       size_t port_index = port_vector.size() + start_index;
-      std::stringstream stream;
-      stream << common_prefix << port_index << common_postfix;
-      port_vector.push_back(TPort(stream.str(), this));
+      port_vector.push_back(TPort(common_prefix + std::to_string(port_index) + common_postfix, this));
       port_vector.back().Init();
     }
   }
@@ -281,6 +298,11 @@ protected:
 
   virtual ~tComponent();
 
+  /*!
+   * Removes component's memory block from register used to determine parents of ports (see internal/register.h).
+   * Derived classes overriding this method should call it.
+   */
+  virtual void PostChildInit() override;
 
   /*! GetContainer function for e.g. tParameter */
   tFrameworkElement& GetParameterParent();
@@ -309,16 +331,24 @@ private:
 
   template <typename TPort, typename TElement, typename TContainer, TContainer& (TElement::*GET_CONTAINER)()>
   friend class tConveniencePort;
+  template <typename TPort>
+  friend class tLazyPort;
 
   /*! Element aggregating parameters */
   core::tFrameworkElement* parameters;
 
+  /*! Handle to memory block that this component resides in */
+  internal::tMemoryBlockHandle memory_block;
+
   /*! Number of ports already created that have auto-generated names */
   int auto_name_port_count;
 
   /*! Counter should be reset for every module class in type hierarchy. This helper variable is used to detect this. */
   const char* count_for_type;
 
+  /*! Lazy ports of this component (their ports have possibly not been created yet) */
+  std::vector<internal::tLazyPortBase*> lazy_ports;
+
   /*!
    * Global setting as to whether dedicated component visualization outputs (tVisualizationOutput)
    * should be created.
@@ -134,6 +134,7 @@ void tCompositeComponent::PostChildInit()
 #endif
     }
   }
+  tComponent::PostChildInit();
 }
 
 //----------------------------------------------------------------------
@@ -62,6 +62,30 @@ namespace structure
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+template <typename TPort, size_t Tsize>
+class tPortArray;
+template <typename TPort>
+class tDynamicPortArray;
+template <typename TPort>
+class tLazyPort;
+
+namespace internal
+{
+
+/*!
+ * Passed to convenience port constructor by port arrays (see tPortArray.h) and lazy ports (see tLazyPort.h) in order to create a port.
+ * Unlike other constructors, no index for auto-generated port names is consumed.
+ */
+struct tPortArrayElement
+{
+  /*! Name of port */
+  std::string name;
+
+  /*! Component that port array belongs to */
+  core::tFrameworkElement* component;
+};
+
+}
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -89,7 +113,14 @@ class tConveniencePort : public TPort
 //----------------------------------------------------------------------
 public:
 
-  tConveniencePort() : TPort(MakeStandardCreationInfo(this->GetPortName(), &(this->FindParent()->*GET_CONTAINER)())) {}
+  tConveniencePort() : TPort(MakeStandardCreationInfo(FindParent(this))) {}
+
+  /*!
+   * Creates element of port array (see tPortArray.h)
+   *
+   * \param element Name and component of port
+   */
+  tConveniencePort(internal::tPortArrayElement element) : TPort(MakeArrayElementCreationInfo(element)) {}
 
   /*!
    * Constructor takes variadic argument list... just any properties you want to assign to port.
@@ -139,26 +170,43 @@ public:
 //----------------------------------------------------------------------
 private:
 
-  /*! \return Parent module of parameter */
-  TElement* FindParent()
+  template <typename TArrayPort, size_t Tsize>
+  friend class tPortArray;
+  template <typename TArrayPort>
+  friend class tDynamicPortArray;
+  template <typename TLazyPort>
+  friend class tLazyPort;
+
+  /*! Framework element class these ports belong to */
+  typedef TElement tParentElement;
+
+  /*!
+   * \param address Address of port (or port array)
+   * \return Parent module of port
+   */
+  static TElement* FindParent(void* address)
   {
-    return static_cast<TElement*>(internal::FindParent(this));
+    return static_cast<TElement*>(internal::FindParent(address));
+  }
+
+  /*!
+   * \param parent Parent module of port
+   * \return Framework element that port is added to (typically port group)
+   */
+  static TContainer& GetContainer(TElement* parent)
+  {
+    return (parent->*GET_CONTAINER)();
   }
 
   /*! Get auto-generated port name */
-  std::string GetPortName()
+  static const std::string& GetPortName(TElement* parent)
   {
-    TElement* parent = FindParent();
-    return internal::GetAutoGeneratedPortName(parent, UpdateCurrentPortNameIndex());
+    return internal::GetAutoGeneratedPortName(parent, UpdateCurrentPortNameIndex(parent));
   }
 
   /*! Get & update current index for auto-generated port names */
-  int UpdateCurrentPortNameIndex(TElement* parent = NULL)
+  static int UpdateCurrentPortNameIndex(TElement* parent)
   {
-    if (parent == NULL)
-    {
-      parent = FindParent();
-    }
     if (typeid(*parent).name() != parent->count_for_type) // detect class change when traversing module type hierarchy
     {
       parent->count_for_type = typeid(*parent).name();
@@ -171,12 +219,14 @@ private:
 
   /*!
    * Create port creation info for this convenience port (non-template constructor)
+   *
+   * \param parent Parent of port (resolved only once per port)
    */
-  tConstructorParameters MakeStandardCreationInfo(const std::string& name, core::tFrameworkElement* parent)
+  tConstructorParameters MakeStandardCreationInfo(TElement* parent)
   {
     tConstructorParameters result;
-    result.name = name;
-    result.parent = parent;
+    result.name = GetPortName(parent);
+    result.parent = &(parent->*GET_CONTAINER)();
     if (result.parent && typeid(*result.parent) == typeid(core::tPortGroup))
     {
       result.flags |= static_cast<core::tPortGroup*>(result.parent)->GetDefaultPortFlags();
@@ -184,6 +234,21 @@ private:
     return result;
   }
 
+  /*!
+   * Create port creation info for element of port array
+   */
+  tConstructorParameters MakeArrayElementCreationInfo(internal::tPortArrayElement& element)
+  {
+    tConstructorParameters result;
+    result.name = element.name;
+    result.parent = &(static_cast<TElement*>(element.component)->*GET_CONTAINER)();
+    if (typeid(*result.parent) == typeid(core::tPortGroup))
+    {
+      result.flags |= static_cast<core::tPortGroup*>(result.parent)->GetDefaultPortFlags();
+    }
+    return result;
+  }
+
   /*!
    * Create port creation info for this convenience port (template constructor)
    */
@@ -194,37 +259,30 @@ private:
     static_assert(!std::is_base_of<tConveniencePort, A1>::value, "No ports may be passed to this method");
 
     tConstructorParameters result;
+    TElement* parent = NULL;
     if (data_ports::IsString<A1>::value)
     {
       result = core::tPortWrapperBase::tConstructorArguments<tConstructorParameters>(arg1, rest...);
+      parent = result.parent ? static_cast<TElement*>(result.parent) : FindParent(this);
       if (result.name.length() == 0)
       {
-        result.name = this->GetPortName();
+        result.name = GetPortName(parent);
       }
       else
       {
-        if (result.parent == NULL)
-        {
-          this->UpdateCurrentPortNameIndex(this->FindParent());
-        }
-        else
-        {
-          this->UpdateCurrentPortNameIndex(static_cast<TElement*>(result.parent));
-        }
+        UpdateCurrentPortNameIndex(parent);
       }
     }
     else
     {
-      result = core::tPortWrapperBase::tConstructorArguments<tConstructorParameters>(this->GetPortName(), arg1, rest...);
-    }
-    if (result.parent == NULL)
-    {
-      result.parent = &(this->FindParent()->*GET_CONTAINER)();
-    }
-    else
-    {
-      result.parent = &(static_cast<TElement*>(result.parent)->*GET_CONTAINER)();
+      parent = FindParent(this);
+      result = core::tPortWrapperBase::tConstructorArguments<tConstructorParameters>(GetPortName(parent), arg1, rest...);
+      if (result.parent)
+      {
+        parent = static_cast<TElement*>(result.parent);
+      }
     }
+    result.parent = &(parent->*GET_CONTAINER)();
     if (result.parent && typeid(*result.parent) == typeid(core::tPortGroup))
     {
       result.flags |= static_cast<core::tPortGroup*>(result.parent)->GetDefaultPortFlags();
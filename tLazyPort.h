@@ -0,0 +1,234 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/tLazyPort.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tLazyPort
+ *
+ * \b tLazyPort
+ *
+ * Convenience port that is only created when it is actually needed.
+ * Intended for optional ports (e.g. diagnostic outputs) that are rarely connected.
+ * Until then, only the port's name, its component and a lightweight placeholder
+ * element are stored (e.g. tLazyPort<tOutput<double>> debug_output;).
+ * The placeholder represents the port in the framework element tree - so tools (e.g. finstruct)
+ * show it and connections in config or structure files can refer to it (see internal::tLazyPortBase).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__tLazyPort_h__
+#define __plugins__structure__tLazyPort_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/tComponent.h"
+#include "plugins/structure/internal/tLazyPortBase.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Lazily created convenience port
+/*!
+ * Convenience port that is only created on first connection via its ConnectTo(),
+ * when a connector to its path is created (e.g. from a config file) or
+ * when Materialize() is called (e.g. via tComponent::MaterializeLazyPort()).
+ * Before, publishing data is a no-op and the port is reported as unconnected.
+ * Until then, a placeholder element represents the port in the framework element tree.
+ *
+ * The name index for auto-generated port names is consumed on construction -
+ * so lazy ports may be mixed with other convenience ports.
+ *
+ * Lazy ports must be members of their component (they are registered there).
+ * Materialization is not thread-safe: it should be done during component construction or
+ * by the thread executing the component.
+ *
+ * \tparam TPort Convenience port type (e.g. tModule::tOutput<double>)
+ */
+template <typename TPort>
+class tLazyPort : public internal::tLazyPortBase
+{
+  typedef typename TPort::tParentElement tParentElement;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Creates lazy port with auto-generated name (only possible when plain member of component)
+   */
+  tLazyPort() : tLazyPort(TPort::FindParent(this))
+  {}
+
+  /*!
+   * \param name Name of port
+   * \param parent Component that port belongs to
+   */
+  tLazyPort(const std::string& name, core::tFrameworkElement* parent) :
+    tLazyPortBase(name, TPort::GetContainer(static_cast<tParentElement*>(parent))),
+    component(static_cast<tParentElement*>(parent)),
+    port()
+  {
+    TPort::UpdateCurrentPortNameIndex(component);
+    component->lazy_ports.push_back(this);
+  }
+
+  tLazyPort(const tLazyPort&) = delete;
+  tLazyPort& operator=(const tLazyPort&) = delete;
+
+  ~tLazyPort()
+  {
+    // Only wrapper is deleted - port is deleted with its component
+    auto& lazy_ports = static_cast<tComponent*>(component)->lazy_ports;
+    lazy_ports.erase(std::remove(lazy_ports.begin(), lazy_ports.end(), this), lazy_ports.end());
+  }
+
+  /*!
+   * Connects port to another port - creating it if this has not been done yet
+   * (takes the same arguments as ConnectTo() of the port)
+   */
+  template <typename ... TArgs>
+  auto ConnectTo(TArgs&&... args) -> decltype(std::declval<TPort&>().ConnectTo(std::forward<TArgs>(args)...))
+  {
+    return Materialize().ConnectTo(std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * \return Port - or nullptr if it has not been created yet
+   */
+  TPort* GetPort()
+  {
+    return port.get();
+  }
+
+  /*!
+   * \return Has port been created and changed since last reset?
+   */
+  bool HasChanged()
+  {
+    return port && port->HasChanged();
+  }
+
+  /*!
+   * \return Has port been created and is it connected?
+   */
+  bool IsConnected() const
+  {
+    return port && port->IsConnected();
+  }
+
+  /*!
+   * \return Has port been created?
+   */
+  bool IsMaterialized() const
+  {
+    return port.get();
+  }
+
+  /*!
+   * Creates port in place of its placeholder (if this has not been done yet).
+   * If component has already been initialized, port is initialized, too.
+   *
+   * \return Port
+   */
+  TPort& Materialize()
+  {
+    if (!port)
+    {
+      DeletePlaceholder();
+      port.reset(new TPort(internal::tPortArrayElement { name, component }));
+      if (component->IsReady())
+      {
+        port->Init();
+      }
+    }
+    return *port;
+  }
+
+  virtual void MaterializePort() override
+  {
+    Materialize();
+  }
+
+  /*!
+   * Publishes data via port (takes the same arguments as Publish() of the port).
+   * No-op if port has not been created yet.
+   */
+  template <typename ... TArgs>
+  void Publish(TArgs&&... args)
+  {
+    if (port)
+    {
+      port->Publish(std::forward<TArgs>(args)...);
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Component that port belongs to */
+  tParentElement* component;
+
+  /*! Port wrapper (nullptr until port is created) */
+  std::unique_ptr<TPort> port;
+
+  explicit tLazyPort(tParentElement* component) :
+    tLazyPortBase(TPort::GetPortName(component), TPort::GetContainer(component)),
+    component(component),
+    port()
+  {
+    component->lazy_ports.push_back(this);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -34,11 +34,14 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
 #include "plugins/scheduling/tPeriodicFrameworkElementTask.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/structure/internal/tTaskProfiler.h"
+#include "plugins/structure/internal/tracing.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -76,13 +79,36 @@ tModule::tModule(tFrameworkElement *parent, const std::string &name, bool share_
     output(NULL),
     share_ports(share_ports),
     update_task(*this),
-    input_changed(true)
+    update_profiler(),
+    input_changed(true),
+    skip_update_if_unchanged(false),
+    update_called(false),
+    update_skipped(false),
+    update_triggers()
 {
 }
 
 tModule::~tModule()
 {}
 
+void tModule::AddUpdateTrigger(const core::tPortWrapperBase& input_port)
+{
+  core::tAbstractPort* port = input_port.GetWrapped();
+  if ((!port) || port->GetParent() != input)
+  {
+    FINROC_LOG_PRINT(ERROR, "Update triggers must be input ports of this module. Ignoring port.");
+    return;
+  }
+  update_triggers.push_back(port);
+  skip_update_if_unchanged = true;
+}
+
+const std::vector<data_ports::common::tAbstractDataPort*>& tModule::ChangedInputs()
+{
+  static const std::vector<data_ports::common::tAbstractDataPort*> cNO_PORTS;
+  return input ? GetChangedPorts(*input) : cNO_PORTS;
+}
+
 void tModule::PostChildInit()
 {
   CheckStaticParameters(); // evaluate static parameters before we create the task
@@ -91,21 +117,73 @@ void tModule::PostChildInit()
   {
     execution_duration = data_ports::tOutputPort<rrlib::time::tDuration>(&GetProfilingPortGroup(), "Update() Duration");
     execution_duration.Init();
+    update_profiler.reset(new internal::tTaskProfiler(GetProfilingPortGroup(), "Update()"));
   }
+  this->update_task.traced_task = internal::RegisterTracedTask(GetQualifiedName() + " Update()", *this);
   this->AddAnnotation(*new scheduling::tPeriodicFrameworkElementTask(this->input, this->output, this->update_task, execution_duration));
+  if (this->input)
+  {
+    PrepareChangedFlagProcessing(*this->input);
+  }
+  tModuleBase::PostChildInit();
+}
+
+void tModule::PrepareDelete()
+{
+  if (update_profiler)
+  {
+    update_profiler->WaitForPublication(); // statistics must not be published while profiling ports are deleted
+  }
+  tModuleBase::PrepareDelete();
+}
+
+bool tModule::UpdateTriggered()
+{
+  if ((!input) || (!input_changed))
+  {
+    return false;
+  }
+  if (update_triggers.empty())
+  {
+    return true;
+  }
+  for (data_ports::common::tAbstractDataPort * changed_port : ChangedInputs())
+  {
+    if (std::find(update_triggers.begin(), update_triggers.end(), changed_port) != update_triggers.end())
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
 tModule::UpdateTask::UpdateTask(tModule& module)
-  : module(module)
+  : module(module),
+    traced_task({ 0, nullptr })
 {}
 
 void tModule::UpdateTask::ExecuteTask()
 {
-  this->module.CheckParameters();
+  internal::tTraceScope trace(this->traced_task);
+  if (!this->module.IsExecutionCycle(tCycleFunction::UPDATE))
+  {
+    return;
+  }
+  internal::tTaskProfiler::tScope profile(this->module.update_profiler.get());
+  bool parameters_changed = this->module.CheckParameters();
   if (this->module.input)
   {
-    this->module.input_changed = this->module.ProcessChangedFlags(*this->module.input);
+    this->module.input_changed = this->module.ProcessChangedFlags(*this->module.input, this->module.update_skipped);
+  }
+  if (this->module.skip_update_if_unchanged && this->module.update_called && (!parameters_changed) && (!this->module.UpdateTriggered()))
+  {
+    this->module.update_skipped = true;
+    return;
   }
+  this->module.update_called = true;
+  this->module.update_skipped = false;
+  tBudgetScope budget(this->module, tCycleFunction::UPDATE);
+  internal::tTaskProfiler::tAllocationScope allocations(this->module.update_profiler.get());
   this->module.Update();
 }
 
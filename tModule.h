@@ -47,6 +47,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/structure/tModuleBase.h"
+#include "plugins/structure/internal/tracing.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -152,8 +153,62 @@ protected:
     return input_changed;
   }
 
+  /*!
+   * May be called in Update() method to obtain the input ports
+   * that have changed since last call to Update()
+   * (e.g. in order to recompute only results that depend on these ports).
+   *
+   * \return Changed input ports
+   */
+  const std::vector<data_ports::common::tAbstractDataPort*>& ChangedInputs();
+
+  /*!
+   * Change sequence number of module's inputs:
+   * incremented in every cycle in which any input port changed.
+   * Together with GetChangeSequence(port), this can be used to determine which inputs
+   * changed since some earlier cycle.
+   *
+   * \return Change sequence number of module's inputs
+   */
+  uint64_t InputChangeSequence()
+  {
+    return input ? GetChangeSequence(*input) : 0;
+  }
+
   virtual void PostChildInit() override;
 
+  virtual void PrepareDelete() override;
+
+  /*!
+   * Adds input port that triggers Update() calls:
+   * Enables skipping of unchanged cycles (see SetSkipUpdateIfUnchanged()) and restricts the inputs considered
+   * to the trigger ports - so Update() is only called in cycles in which new data arrived at any of them
+   * (or a parameter change was processed).
+   * The module's task remains in the thread container's schedule (so data dependencies are still considered):
+   * it is executed every cycle, but returns before calling Update() if no trigger port has changed.
+   * Changes of other input ports in skipped cycles are kept - so InputChanged(), ChangedInputs() and
+   * the ports' HasChanged() report them in the next Update() call.
+   * (Should be called in constructor)
+   *
+   * \param input_port Input port of this module
+   */
+  void AddUpdateTrigger(const core::tPortWrapperBase& input_port);
+
+  /*!
+   * Enables or disables skipping of unchanged cycles:
+   * If enabled, Update() is not called in cycles in which no input port (or no trigger port - see AddUpdateTrigger()) changed
+   * and no parameter change was processed (the first cycle is never skipped).
+   * Outputs keep their last published values then.
+   * Intended for modules whose outputs are a pure function of inputs and parameters (e.g. unit converters).
+   * (Should be called in constructor; disabled by default)
+   *
+   * \param skip Skip Update() if nothing changed?
+   */
+  void SetSkipUpdateIfUnchanged(bool skip)
+  {
+    skip_update_if_unchanged = skip;
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -173,13 +228,34 @@ private:
   public:
     UpdateTask(tModule& module);
     virtual void ExecuteTask() override;
+
+    /*! Task in trace (with zero id if not traced) */
+    internal::tTracedTask traced_task;
   };
 
   UpdateTask update_task;
 
-  /*! Has any input port changed since last cycle? */
+  /*! Profiles Update() calls (only created if profiling is enabled) */
+  std::unique_ptr<internal::tTaskProfiler> update_profiler;
+
+  /*! Has any input port changed since last call to Update()? */
   bool input_changed;
 
+  /*! Skip Update() if no input or parameter changed? (see SetSkipUpdateIfUnchanged()) */
+  bool skip_update_if_unchanged;
+
+  /*! Has Update() been called yet? */
+  bool update_called;
+
+  /*! Was Update() skipped in last cycle? (changes of input ports are kept until Update() is called then) */
+  bool update_skipped;
+
+  /*! Input ports that trigger Update() calls (if empty, any input port does) */
+  std::vector<core::tAbstractPort*> update_triggers;
+
+  /*! \return Has any input port that triggers Update() calls changed? (called after changed flags have been processed) */
+  bool UpdateTriggered();
+
   /*! Called periodically with cycle time of thread container this module belongs to */
   virtual void Update() = 0;
 };
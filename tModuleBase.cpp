@@ -32,11 +32,19 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <chrono>
+#include <thread>
+#include <map>
+#include "core/tAnnotation.h"
 #include "core/tFrameworkElementTags.h"
+#include "rrlib/thread/tLock.h"
+#include "plugins/scheduling/tExecutionControl.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/structure/internal/tInterfaceChangeTracker.h"
+#include "plugins/structure/tParameterSnapshot.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -62,26 +70,160 @@ namespace structure
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
-static constexpr uint cMANDATORY_PORT_FLAGS_FOR_CHANGED_CHECK = (core::tFrameworkElementFlag::READY | core::tFrameworkElementFlag::PUSH_STRATEGY).Raw();
 
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
 
+/*!
+ * Annotation of thread containers with divided modules (deleted with the container):
+ * Next automatic phase for each execution divisor
+ */
+class tModuleBase::tAutomaticPhases : public core::tAnnotation
+{
+public:
+
+  /*! Mutex for next_phases */
+  rrlib::thread::tMutex mutex;
+
+  /*! Next automatic phase by execution divisor */
+  std::map<unsigned int, unsigned int> next_phases;
+};
+
 tModuleBase::tModuleBase(tFrameworkElement *parent, const std::string &name)
   : tComponent(parent, name),
-    parameters_changed()
+    execution_budgets(),
+    execution_rate(),
+    parameters_changed(),
+    asynchronous_parameter_change(false),
+    parameter_change_job(tParameterChangeJobState::IDLE),
+    parameter_change_job_object(*this),
+    asynchronously_changed_parameters(),
+    parameter_snapshots(),
+    change_trackers()
 {
   core::tFrameworkElementTags::AddTag(*this, "module");
 }
 
-void tModuleBase::CheckParameters()
+tModuleBase::~tModuleBase()
 {
-  if (parameters_changed.parameters_changed && this->ParameterParentCreated())
+  WaitForParameterChangeJob();
+}
+
+bool tModuleBase::CheckParameters()
+{
+  tParameterChangeDetector& detector = parameters_changed;
+  tParameterChangeJobState job_state = parameter_change_job.load(std::memory_order_acquire);
+  uint64_t processed_epoch = detector.processed_epoch.load(std::memory_order_acquire);
+  bool changes_pending = detector.change_epoch.load(std::memory_order_acquire) != processed_epoch && this->ParameterParentCreated();
+  if (job_state == tParameterChangeJobState::RUNNING || (job_state == tParameterChangeJobState::IDLE && (!changes_pending)))
   {
+    return false;
+  }
+  if (detector.processing.exchange(true, std::memory_order_acquire))
+  {
+    return false; // another thread is processing parameter changes
+  }
+
+  bool changes_applied = false;
+  if (parameter_change_job.load(std::memory_order_acquire) == tParameterChangeJobState::COMPLETED)
+  {
+    // Cycle boundary: results of asynchronous OnParametersChanged() call become visible
+    for (internal::tParameterSnapshotBase * snapshot : parameter_snapshots)
+    {
+      snapshot->Swap();
+    }
+    parameter_change_job.store(tParameterChangeJobState::IDLE, std::memory_order_relaxed);
+    changes_applied = true;
+  }
+
+  if (changes_pending)
+  {
+    // Changes that occur from now on are processed in the next call
+    uint64_t epoch = detector.change_epoch.load(std::memory_order_acquire);
     this->ProcessChangedFlags(this->GetParameterParent());
-    parameters_changed.parameters_changed = false;
-    this->OnParameterChange();
+
+    // On first call, all parameters are passed; afterwards, only the changed ones
+    bool initial_call = processed_epoch == 0;
+    std::vector<data_ports::common::tAbstractDataPort*> all_parameters;
+    if (initial_call)
+    {
+      core::tFrameworkElement& parameter_parent = this->GetParameterParent();
+      for (auto it = parameter_parent.ChildPortsBegin(); it != parameter_parent.ChildPortsEnd(); ++it)
+      {
+        all_parameters.push_back(&static_cast<data_ports::common::tAbstractDataPort&>(*it));
+      }
+    }
+    const std::vector<data_ports::common::tAbstractDataPort*>& changed_parameters = initial_call ? all_parameters : this->GetChangedPorts(this->GetParameterParent());
+
+    // Changes might have been consumed by a previous call already (they occurred between reading epoch and processing flags)
+    if (initial_call || (!changed_parameters.empty()))
+    {
+      if (asynchronous_parameter_change && (!initial_call))
+      {
+        asynchronously_changed_parameters = changed_parameters;
+        parameter_change_job.store(tParameterChangeJobState::RUNNING, std::memory_order_release);
+        internal::ExecuteInBackground(parameter_change_job_object);
+      }
+      else
+      {
+        this->OnParametersChanged(changed_parameters, initial_call);
+        for (internal::tParameterSnapshotBase * snapshot : parameter_snapshots)
+        {
+          snapshot->Swap();
+        }
+        changes_applied = true;
+      }
+    }
+    detector.processed_epoch.store(epoch, std::memory_order_release);
+  }
+  detector.processing.store(false, std::memory_order_release);
+  return changes_applied;
+}
+
+void tModuleBase::AssignAutomaticPhase()
+{
+  // Round-robin among modules with same divisor in same container
+  unsigned int divisor = execution_rate->divisor.Get();
+  unsigned int phase = 0;
+  if (execution_rate->automatic_phases)
+  {
+    rrlib::thread::tLock lock(execution_rate->automatic_phases->mutex);
+    phase = execution_rate->automatic_phases->next_phases[divisor]++;
+  }
+  execution_rate->automatic_phase.store(phase, std::memory_order_relaxed);
+  execution_rate->automatic_phase_divisor.store(divisor, std::memory_order_release);
+}
+
+bool tModuleBase::CheckExecutionRate(tCycleFunction function)
+{
+  unsigned int divisor = execution_rate->divisor.Get();
+  uint64_t cycle = execution_rate->cycle_counters[static_cast<size_t>(function)]++;
+  if (divisor != execution_rate->automatic_phase_divisor.load(std::memory_order_acquire) && (!execution_rate->phase_assignment_pending.exchange(true, std::memory_order_acq_rel)))
+  {
+    internal::ExecuteInBackground(execution_rate->phase_assignment_job); // divisor has changed (assignment acquires a lock)
+  }
+  if (divisor <= 1)
+  {
+    return true;
+  }
+  int phase = execution_rate->phase.Get();
+  return cycle % divisor == (phase < 0 ? execution_rate->automatic_phase.load(std::memory_order_relaxed) : static_cast<unsigned int>(phase)) % divisor;
+}
+
+void tModuleBase::CheckExecutionBudget(tCycleFunction function, std::chrono::steady_clock::duration duration)
+{
+  tExecutionBudget& budget = *execution_budgets[static_cast<size_t>(function)];
+  int64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  if (duration_ns > budget.worst_case_ns.load(std::memory_order_relaxed))
+  {
+    budget.worst_case_ns.store(duration_ns, std::memory_order_relaxed);
+  }
+  rrlib::time::tDuration budget_value = budget.budget.Get();
+  if (budget_value > rrlib::time::tDuration::zero() && duration > budget_value)
+  {
+    budget.overruns.fetch_add(1, std::memory_order_relaxed);
+    this->OnBudgetExceeded(function, std::chrono::duration_cast<rrlib::time::tDuration>(duration), budget_value);
   }
 }
 
@@ -99,6 +241,24 @@ core::tPortGroup* tModuleBase::CreateInterface(const std::string& name, bool sha
   return new core::tPortGroup(this, name, tFlag::INTERFACE | extra_flags, default_port_flags | (share_ports ? tFlags(tFlag::SHARED) : tFlags()));
 }
 
+internal::tInterfaceChangeTracker* tModuleBase::FindChangeTracker(core::tFrameworkElement& port_group) const
+{
+  for (auto & tracker : change_trackers)
+  {
+    if (&tracker->GetPortGroup() == &port_group)
+    {
+      return tracker.get();
+    }
+  }
+  return nullptr;
+}
+
+uint64_t tModuleBase::GetBudgetOverrunCount(tCycleFunction function) const
+{
+  const tExecutionBudget* budget = execution_budgets[static_cast<size_t>(function)].get();
+  return budget ? budget->overruns.load(std::memory_order_relaxed) : 0;
+}
+
 core::tPortGroup& tModuleBase::GetProfilingPortGroup()
 {
   core::tFrameworkElement* port_group = this->GetChild("Profiling");
@@ -113,28 +273,197 @@ core::tPortGroup& tModuleBase::GetProfilingPortGroup()
   return static_cast<core::tPortGroup&>(*port_group);
 }
 
+uint64_t tModuleBase::GetChangeSequence(const core::tPortWrapperBase& port)
+{
+  core::tAbstractPort* wrapped = port.GetWrapped();
+  internal::tInterfaceChangeTracker* tracker = wrapped ? FindChangeTracker(*wrapped->GetParent()) : nullptr;
+  return tracker ? tracker->GetChangeSequence(*wrapped) : 0;
+}
+
+uint64_t tModuleBase::GetChangeSequence(core::tFrameworkElement& port_group)
+{
+  internal::tInterfaceChangeTracker* tracker = FindChangeTracker(port_group);
+  return tracker ? tracker->GetChangeSequence() : 0;
+}
+
+const std::vector<data_ports::common::tAbstractDataPort*>& tModuleBase::GetChangedPorts(core::tFrameworkElement& port_group)
+{
+  static const std::vector<data_ports::common::tAbstractDataPort*> cNO_PORTS;
+  internal::tInterfaceChangeTracker* tracker = FindChangeTracker(port_group);
+  return tracker ? tracker->GetChangedPorts() : cNO_PORTS;
+}
+
+rrlib::time::tDuration tModuleBase::GetWorstCaseExecutionTime(tCycleFunction function) const
+{
+  const tExecutionBudget* budget = execution_budgets[static_cast<size_t>(function)].get();
+  return std::chrono::duration_cast<rrlib::time::tDuration>(std::chrono::nanoseconds(budget ? budget->worst_case_ns.load(std::memory_order_relaxed) : 0));
+}
+
+void tModuleBase::PostChildInit()
+{
+  if (this->ParameterParentCreated())
+  {
+    PrepareChangedFlagProcessing(this->GetParameterParent());
+    if (asynchronous_parameter_change)
+    {
+      core::tFrameworkElement& parameter_parent = this->GetParameterParent();
+      size_t parameter_count = 0;
+      for (auto it = parameter_parent.ChildPortsBegin(); it != parameter_parent.ChildPortsEnd(); ++it)
+      {
+        parameter_count++;
+      }
+      asynchronously_changed_parameters.reserve(parameter_count);
+      internal::StartBackgroundWorker();
+    }
+  }
+  if (execution_rate)
+  {
+    // Thread container executing this module
+    core::tFrameworkElement* container = this->GetParent();
+    while (container && (!container->GetAnnotation<scheduling::tExecutionControl>()))
+    {
+      container = container->GetParent();
+    }
+    if (container)
+    {
+      rrlib::thread::tLock lock(container->GetStructureMutex());
+      execution_rate->automatic_phases = container->GetAnnotation<tAutomaticPhases>();
+      if (!execution_rate->automatic_phases)
+      {
+        execution_rate->automatic_phases = new tAutomaticPhases();
+        container->AddAnnotation(*execution_rate->automatic_phases);
+      }
+    }
+    AssignAutomaticPhase();
+    internal::StartBackgroundWorker();
+  }
+  tComponent::PostChildInit();
+}
+
+void tModuleBase::PrepareDelete()
+{
+  // OnParametersChanged() must not be running when derived class members are destructed
+  WaitForParameterChangeJob();
+  while (execution_rate && execution_rate->phase_assignment_pending.load(std::memory_order_acquire))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  tComponent::PrepareDelete();
+}
+
+void tModuleBase::PrepareChangedFlagProcessing(core::tFrameworkElement& port_group)
+{
+  internal::tInterfaceChangeTracker* tracker = FindChangeTracker(port_group);
+  if (!tracker)
+  {
+    change_trackers.emplace_back(new internal::tInterfaceChangeTracker(port_group));
+    tracker = change_trackers.back().get();
+  }
+  tracker->UpdatePortList();
+}
+
 void tModuleBase::tParameterChangeDetector::OnPortChange(data_ports::tChangeContext& change_context)
 {
-  parameters_changed = true;
+  change_epoch.fetch_add(1, std::memory_order_acq_rel);
 }
 
-bool tModuleBase::ProcessChangedFlags(core::tFrameworkElement& port_group)
+bool tModuleBase::ProcessChangedFlags(core::tFrameworkElement& port_group, bool keep_previous_changes)
 {
+  internal::tInterfaceChangeTracker* tracker = this->IsReady() ? FindChangeTracker(port_group) : nullptr;
+  if (tracker)
+  {
+    return tracker->ProcessChangedFlags(keep_previous_changes);
+  }
+
+  // Module is not initialized yet or port group was not prepared: process all ports
   bool any_changed = false;
   for (auto it = port_group.ChildPortsBegin(); it != port_group.ChildPortsEnd(); ++it)
   {
-    if ((it->GetAllFlags().Raw() & cMANDATORY_PORT_FLAGS_FOR_CHANGED_CHECK) == cMANDATORY_PORT_FLAGS_FOR_CHANGED_CHECK || (!this->IsReady()))
+    data_ports::common::tAbstractDataPort& port = static_cast<data_ports::common::tAbstractDataPort&>(*it);
+    bool changed = port.HasChanged();
+    port.ResetChanged();
+    if (keep_previous_changes && port.GetCustomChangedFlag() != data_ports::tChangeStatus::NO_CHANGE)
     {
-      bool changed = static_cast<data_ports::common::tAbstractDataPort&>(*it).HasChanged();
-      static_cast<data_ports::common::tAbstractDataPort&>(*it).ResetChanged();
-      any_changed |= changed;
-      static_cast<data_ports::common::tAbstractDataPort&>(*it).SetCustomChangedFlag(changed ?
-          data_ports::tChangeStatus::CHANGED : data_ports::tChangeStatus::NO_CHANGE);
+      any_changed = true;
+      continue;
     }
+    any_changed |= changed;
+    port.SetCustomChangedFlag(changed ? data_ports::tChangeStatus::CHANGED : data_ports::tChangeStatus::NO_CHANGE);
   }
   return any_changed;
 }
 
+void tModuleBase::SetExecutionDivisor(unsigned int divisor, int phase)
+{
+  if (execution_rate)
+  {
+    execution_rate->divisor.Set(divisor);
+    execution_rate->phase.Set(phase);
+    return;
+  }
+  if (IsReady())
+  {
+    FINROC_LOG_PRINT(WARNING, "Execution divisor set after module has been initialized. It cannot be configured and phase is not assigned automatically. Call SetExecutionDivisor() in constructor to avoid this.");
+  }
+  execution_rate.reset(new tExecutionRate(*this, divisor, phase));
+  if (IsReady())
+  {
+    execution_rate->divisor.Init();
+    execution_rate->phase.Init();
+  }
+}
+
+void tModuleBase::SetExecutionBudget(tCycleFunction function, rrlib::time::tDuration budget)
+{
+  static const char* cFUNCTION_NAMES[] = { "Update()", "Sense()", "Control()" };
+  std::unique_ptr<tExecutionBudget>& execution_budget = execution_budgets[static_cast<size_t>(function)];
+  if (execution_budget)
+  {
+    execution_budget->budget.Set(budget);
+    return;
+  }
+  if (IsReady())
+  {
+    FINROC_LOG_PRINT(WARNING, "Execution budget set after module has been initialized. Budget parameter cannot be configured. Call SetExecutionBudget() in constructor to avoid this.");
+  }
+  execution_budget.reset(new tExecutionBudget(*this, cFUNCTION_NAMES[static_cast<size_t>(function)], budget));
+  if (IsReady())
+  {
+    execution_budget->budget.Init();
+  }
+}
+
+void tModuleBase::tPhaseAssignmentJob::Execute()
+{
+  module.AssignAutomaticPhase();
+  module.execution_rate->phase_assignment_pending.store(false, std::memory_order_release);
+}
+
+void tModuleBase::tParameterChangeJob::Execute()
+{
+  try
+  {
+    module.OnParametersChanged(module.asynchronously_changed_parameters, false);
+  }
+  catch (const std::exception& e)
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "OnParametersChanged() of module ", module.GetQualifiedName(), " threw exception: ", e);
+  }
+  catch (...)
+  {
+    FINROC_LOG_PRINT_STATIC(ERROR, "OnParametersChanged() of module ", module.GetQualifiedName(), " threw exception");
+  }
+  module.parameter_change_job.store(tParameterChangeJobState::COMPLETED, std::memory_order_release);
+}
+
+void tModuleBase::WaitForParameterChangeJob()
+{
+  while (parameter_change_job.load(std::memory_order_acquire) == tParameterChangeJobState::RUNNING)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
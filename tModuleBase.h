@@ -40,6 +40,8 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
 #include "rrlib/thread/tTask.h"
 #include "plugins/data_ports/tOutputPort.h"
 #include "plugins/parameters/tParameter.h"
@@ -53,6 +55,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/structure/tComponent.h"
+#include "plugins/structure/internal/background_worker.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -65,6 +68,12 @@ namespace structure
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+namespace internal
+{
+class tInterfaceChangeTracker;
+class tParameterSnapshotBase;
+class tTaskProfiler;
+}
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -154,12 +163,59 @@ public:
 //----------------------------------------------------------------------
 protected:
 
+  virtual ~tModuleBase();
+
+  /*! Cycle functions of modules */
+  enum class tCycleFunction
+  {
+    UPDATE,
+    SENSE,
+    CONTROL
+  };
+
+  /*!
+   * (Should only be used by abstract module classes such as tModule and tSenseControlModule)
+   *
+   * Measures the duration of a cycle function call (from construction to destruction) -
+   * if an execution budget has been set for this function (see SetExecutionBudget()).
+   * If the budget is exceeded, the overrun is recorded and OnBudgetExceeded() is called.
+   */
+  class tBudgetScope
+  {
+  public:
+    tBudgetScope(tModuleBase& module, tCycleFunction function) :
+      module(module),
+      function(function),
+      measure(module.execution_budgets[static_cast<size_t>(function)].get()),
+      start_time(measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+    {}
+
+    ~tBudgetScope()
+    {
+      if (measure)
+      {
+        module.CheckExecutionBudget(function, std::chrono::steady_clock::now() - start_time);
+      }
+    }
+
+  private:
+    tModuleBase& module;
+    tCycleFunction function;
+    bool measure;
+    std::chrono::steady_clock::time_point start_time;
+  };
+
   /*!
    * (Should only be called by abstract module classes such as tModule and tSenseControlModule)
    *
-   * Calls OnParameterChange() if a parameter change was detected and resets change flag
+   * Calls OnParametersChanged() if a parameter change was detected and resets change flag.
+   * May be called by multiple threads concurrently (e.g. sense and control thread):
+   * changes are processed by only one of them.
+   * Also swaps in parameter snapshots (see tParameterSnapshot.h) - so it should be called at the beginning of a cycle.
+   *
+   * \return True if OnParametersChanged() was called - or the results of an asynchronous call became visible
    */
-  void CheckParameters();
+  bool CheckParameters();
 
   /*!
    * Creates interface for this module
@@ -171,6 +227,124 @@ protected:
    */
   core::tPortGroup* CreateInterface(const std::string& name, bool share_ports, tFlags extra_flags = tFlags(), tFlags default_port_flags = tFlags());
 
+  /*!
+   * (relevant for ports in port groups processed with ProcessChangedFlags() - e.g. input ports)
+   *
+   * \param port Port to get change sequence number of
+   * \return Change sequence number of port: equals the change sequence number of its port group when port last changed
+   *         (0 if no change has been detected yet or port group is not processed with ProcessChangedFlags())
+   */
+  uint64_t GetChangeSequence(const core::tPortWrapperBase& port);
+
+  /*!
+   * \param port_group Port group processed with ProcessChangedFlags()
+   * \return Change sequence number of port group: incremented whenever ProcessChangedFlags() detects a change in port group
+   *         (0 if port group has not been prepared or processed yet)
+   */
+  uint64_t GetChangeSequence(core::tFrameworkElement& port_group);
+
+  /*!
+   * \param port_group Port group processed with ProcessChangedFlags()
+   * \return Ports in port group whose changed flags were set in last call to ProcessChangedFlags()
+   *         (and in preceding calls - as long as changes were kept; empty if port group has not been prepared or processed yet)
+   *
+   * (GetChangeSequence() and GetChangedPorts() never create change trackers)
+   */
+  const std::vector<data_ports::common::tAbstractDataPort*>& GetChangedPorts(core::tFrameworkElement& port_group);
+
+  /*!
+   * Prepares processing of changed flags of specified port group (see ProcessChangedFlags()):
+   * Builds list of ports that are eligible for changed flag processing.
+   * The list is rebuilt only when ports in the port group (or their connectors) change.
+   * (Should be called in PostChildInit() of abstract module classes such as tModule and tSenseControlModule.
+   *  Must not be called once the module's tasks are executed, as they look up change trackers without locking)
+   *
+   * \param port_group Port group that will be processed
+   */
+  void PrepareChangedFlagProcessing(core::tFrameworkElement& port_group);
+
+  virtual void PostChildInit() override;
+
+  /*!
+   * \param function Cycle function
+   * \return Number of calls to cycle function that exceeded execution budget
+   */
+  uint64_t GetBudgetOverrunCount(tCycleFunction function) const;
+
+  /*!
+   * \param function Cycle function
+   * \return Longest duration of a call to cycle function (only measured if execution budget was set)
+   */
+  rrlib::time::tDuration GetWorstCaseExecutionTime(tCycleFunction function) const;
+
+  virtual void PrepareDelete() override;
+
+  /*!
+   * (Should only be called by abstract module classes such as tModule and tSenseControlModule)
+   *
+   * Counts cycles of cycle function and determines whether it is to be called in the current cycle
+   * (see SetExecutionDivisor()).
+   *
+   * \param function Cycle function
+   * \return True if function is to be called in current cycle
+   */
+  bool IsExecutionCycle(tCycleFunction function)
+  {
+    return (!execution_rate) || CheckExecutionRate(function);
+  }
+
+  /*!
+   * Lets module run at a fraction of its thread container's rate:
+   * Cycle functions are only called every <divisor>th cycle (e.g. every 10th cycle of a 1 kHz container).
+   * In the other cycles, the module's tasks return immediately (changes of inputs and parameters are processed
+   * in the next cycle in which the module is executed).
+   * Tasks are still recorded in traces in these cycles, as cycle boundaries are inferred from task order.
+   *
+   * Creates static parameters 'Execution Divisor' and 'Execution Phase' with the specified values as defaults -
+   * so that rates can be adjusted in config files.
+   * With automatic phase, phases of divided modules in the same thread container are distributed round-robin
+   * among modules with the same divisor - so that their load is spread over cycles.
+   * If the divisor is changed at runtime, the automatic phase is reassigned (by the background worker).
+   * (Should be called in constructor)
+   *
+   * \param divisor Execution divisor (1 means every cycle)
+   * \param phase Cycle (modulo divisor) in which module is executed (-1 means automatic)
+   */
+  void SetExecutionDivisor(unsigned int divisor, int phase = -1);
+
+  /*!
+   * Sets execution budget for cycle function:
+   * Calls taking longer are counted as overruns and OnBudgetExceeded() is called after them.
+   * Creates a static parameter '<function> Budget' (e.g. 'Update() Budget') with the specified budget as default value -
+   * so that the budget can be adjusted in config files.
+   * (Should be called in constructor)
+   *
+   * \param function Cycle function
+   * \param budget Default execution budget (a static parameter value of zero disables the check)
+   */
+  void SetExecutionBudget(tCycleFunction function, rrlib::time::tDuration budget);
+
+  /*!
+   * Enables asynchronous processing of parameter changes:
+   * OnParametersChanged() is then called by a background (non-real-time) worker thread -
+   * so that expensive computations on parameter changes (e.g. building lookup tables) do not delay the module's task.
+   * The initial call is still made synchronously - so that results are available before the first cycle.
+   *
+   * OnParametersChanged() should store its results in tParameterSnapshot members (see tParameterSnapshot.h).
+   * Once it has completed, these are swapped in atomically at the beginning of the next cycle
+   * (before Update()/Sense()/Control() is called). Parameter changes that occur while
+   * OnParametersChanged() is running are processed in a subsequent call.
+   * Exceptions thrown by asynchronous calls are logged.
+   * Only available for modules whose cycle functions are called by a single task (e.g. tModule - not tSenseControlModule).
+   * (Should be called in constructor; disabled by default)
+   *
+   * \param asynchronous Call OnParametersChanged() asynchronously?
+   */
+  void SetAsynchronousParameterChangeProcessing(bool asynchronous)
+  {
+    asynchronous_parameter_change = asynchronous;
+  }
+
   /*!
    * (Automatically called)
    * Checks and resets all changed flags of ports in specified port group
@@ -180,25 +354,116 @@ protected:
    * of missing a change
    * (which could happen when resetting after Update()/Sense()/Control() call).
    *
+   * Once the module is initialized, only eligible ports that received data are visited
+   * in port groups prepared with PrepareChangedFlagProcessing() (see internal/tInterfaceChangeTracker.h).
+   * In other port groups, all ports are visited.
+   *
    * \param port_group Port group to process
-   * \return Has any port changed since last call?
+   * \param keep_previous_changes Keep changes detected in previous call?
+   *                              (e.g. if Update() was not called with them - custom changed flags that are set remain set then)
+   * \return Has any port changed since last call (that did not keep previous changes)?
    */
-  bool ProcessChangedFlags(tFrameworkElement& port_group);
+  bool ProcessChangedFlags(tFrameworkElement& port_group, bool keep_previous_changes = false);
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  friend class internal::tParameterSnapshotBase;
+
+  /*! Execution budget of a cycle function */
+  struct tExecutionBudget
+  {
+    /*! Budget */
+    parameters::tStaticParameter<rrlib::time::tDuration> budget;
+
+    /*! Number of overruns */
+    std::atomic<uint64_t> overruns;
+
+    /*! Longest duration of a call (in ns) */
+    std::atomic<int64_t> worst_case_ns;
+
+    tExecutionBudget(tModuleBase& module, const std::string& function_name, rrlib::time::tDuration default_budget) :
+      budget(function_name + " Budget", &module, default_budget),
+      overruns(0),
+      worst_case_ns(0)
+    {}
+  };
+
+  /*! Execution budgets of cycle functions (index is tCycleFunction; nullptr if no budget was set) */
+  std::unique_ptr<tExecutionBudget> execution_budgets[3];
+
+  /*! Next automatic phases in a thread container (annotation of thread container - see SetExecutionDivisor()) */
+  class tAutomaticPhases;
+
+  /*! Reassigns automatic phase after execution divisor has changed (handed over to background worker without allocating memory) */
+  class tPhaseAssignmentJob : public internal::tBackgroundJob
+  {
+  public:
+    tPhaseAssignmentJob(tModuleBase& module) : module(module) {}
+
+    virtual void Execute() override;
+
+  private:
+    tModuleBase& module;
+  };
+
+  /*! Execution rate of module (see SetExecutionDivisor()) */
+  struct tExecutionRate
+  {
+    /*! Execution divisor and phase */
+    parameters::tStaticParameter<unsigned int> divisor;
+    parameters::tStaticParameter<int> phase;
+
+    /*! Automatically assigned phase (index among divided modules with same divisor in thread container) */
+    std::atomic<unsigned int> automatic_phase;
+
+    /*! Execution divisor that automatic phase was assigned for (0 if no phase was assigned yet) */
+    std::atomic<unsigned int> automatic_phase_divisor;
+
+    /*! Has phase assignment job been handed over to background worker (and not completed yet)? */
+    std::atomic<bool> phase_assignment_pending;
+
+    /*! Job for reassigning automatic phase */
+    tPhaseAssignmentJob phase_assignment_job;
+
+    /*! Automatic phases of thread container that executes module (nullptr if module is not in a thread container or was not initialized yet) */
+    tAutomaticPhases* automatic_phases;
+
+    /*! Number of cycles per cycle function (index is tCycleFunction) */
+    uint64_t cycle_counters[3];
+
+    tExecutionRate(tModuleBase& module, unsigned int default_divisor, int default_phase) :
+      divisor("Execution Divisor", &module, default_divisor),
+      phase("Execution Phase", &module, default_phase),
+      automatic_phase(0),
+      automatic_phase_divisor(0),
+      phase_assignment_pending(false),
+      phase_assignment_job(module),
+      automatic_phases(nullptr),
+      cycle_counters { 0, 0, 0 }
+    {}
+  };
+
+  /*! Execution rate of module (nullptr if module is executed every cycle) */
+  std::unique_ptr<tExecutionRate> execution_rate;
+
   /*! Introduced this helper class to remove ambiguities when derived classes add listeners to ports */
   class tParameterChangeDetector
   {
     friend class tModuleBase;
 
-    /*! Changed flag that is set whenever a parameter change is detected */
-    volatile bool parameters_changed;
+    /*! Incremented whenever a parameter change is detected (starts at 1, so that changes are processed initially) */
+    std::atomic<uint64_t> change_epoch;
 
-    tParameterChangeDetector() : parameters_changed(true) {}
+    /*! Value of change_epoch when changes were last processed */
+    std::atomic<uint64_t> processed_epoch;
+
+    /*! Set while a thread processes parameter changes (so that e.g. sense and control thread do not process them both) */
+    std::atomic<bool> processing;
+
+    tParameterChangeDetector() : change_epoch(1), processed_epoch(0), processing(false) {}
 
   public:
     /*! Implementation of tPortListenerRaw */
@@ -208,10 +473,94 @@ private:
   /*! Changed flag that is set whenever a parameter change is detected */
   tParameterChangeDetector parameters_changed;
 
+  /*! State of asynchronous OnParametersChanged() call */
+  enum class tParameterChangeJobState
+  {
+    IDLE,      //!< No call is pending
+    RUNNING,   //!< OnParametersChanged() is being executed by background worker
+    COMPLETED  //!< OnParametersChanged() has completed (or thrown) - snapshots need to be swapped
+  };
+
+  /*! Asynchronous OnParametersChanged() call (see SetAsynchronousParameterChangeProcessing()) */
+  class tParameterChangeJob : public internal::tBackgroundJob
+  {
+  public:
+    tParameterChangeJob(tModuleBase& module) : module(module) {}
+
+    virtual void Execute() override;
+
+  private:
+    tModuleBase& module;
+  };
+
+  /*! Is OnParametersChanged() called asynchronously? (see SetAsynchronousParameterChangeProcessing()) */
+  bool asynchronous_parameter_change;
+
+  /*! State of asynchronous OnParametersChanged() call */
+  std::atomic<tParameterChangeJobState> parameter_change_job;
+
+  /*! Job for asynchronous OnParametersChanged() call (handed over to background worker without allocating memory) */
+  tParameterChangeJob parameter_change_job_object;
+
+  /*!
+   * Parameters passed to asynchronous OnParametersChanged() call (not modified while call is running).
+   * Capacity is reserved for all parameters in PostChildInit() - so that assigning changed parameters does not allocate memory.
+   */
+  std::vector<data_ports::common::tAbstractDataPort*> asynchronously_changed_parameters;
+
+  /*! Parameter snapshots of this module (see tParameterSnapshot.h) */
+  std::vector<internal::tParameterSnapshotBase*> parameter_snapshots;
+
+  /*!
+   * Change trackers of port groups processed in ProcessChangedFlags().
+   * Trackers are created in PrepareChangedFlagProcessing() - before the module is executed.
+   */
+  std::vector<std::unique_ptr<internal::tInterfaceChangeTracker>> change_trackers;
+
+  /*! \return Change tracker for specified port group (nullptr if it does not exist) */
+  internal::tInterfaceChangeTracker* FindChangeTracker(core::tFrameworkElement& port_group) const;
+
+  /*! Assigns automatic phase to module for current execution divisor (see SetExecutionDivisor()) */
+  void AssignAutomaticPhase();
+
+  /*! Implementation of IsExecutionCycle() - if execution rate was set */
+  bool CheckExecutionRate(tCycleFunction function);
+
+  /*! Records duration of cycle function call and calls OnBudgetExceeded() if budget was exceeded */
+  void CheckExecutionBudget(tCycleFunction function, std::chrono::steady_clock::duration duration);
+
+  /*! Blocks until a running asynchronous OnParametersChanged() call has completed */
+  void WaitForParameterChangeJob();
+
+
+  /*!
+   * Called after a call to a cycle function has exceeded its execution budget (see SetExecutionBudget()) -
+   * by the thread executing the cycle function.
+   * May be overridden to degrade gracefully (e.g. by lowering resolution in subsequent calls).
+   *
+   * \param function Cycle function that exceeded its budget
+   * \param duration Duration of call
+   * \param budget Execution budget
+   */
+  virtual void OnBudgetExceeded(tCycleFunction function, rrlib::time::tDuration duration, rrlib::time::tDuration budget)
+  {}
 
   /*! Called whenever parameters have changed */
   virtual void OnParameterChange()
   {}
+
+  /*!
+   * Called whenever parameters have changed - with the parameters that changed
+   * (default implementation calls OnParameterChange();
+   * called by background worker thread if asynchronous processing is enabled - see SetAsynchronousParameterChangeProcessing())
+   *
+   * \param changed_parameters Parameters that changed since last call (not called if there are none - except for the initial call)
+   * \param initial_call True on first call: changed_parameters then contains all parameters of the module
+   */
+  virtual void OnParametersChanged(const std::vector<data_ports::common::tAbstractDataPort*>& changed_parameters, bool initial_call)
+  {
+    OnParameterChange();
+  }
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,251 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/tParameterSnapshot.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tParameterSnapshot
+ *
+ * \b tParameterSnapshot
+ *
+ * Double-buffered value derived from parameters in OnParametersChanged()
+ * (e.g. a lookup table or a set of controller gains).
+ * Update()/Sense()/Control() read the current value without locking.
+ * New values become visible at the beginning of the next cycle after OnParametersChanged() -
+ * which allows calling OnParametersChanged() asynchronously
+ * (see tModuleBase::SetAsynchronousParameterChangeProcessing()).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__tParameterSnapshot_h__
+#define __plugins__structure__tParameterSnapshot_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/tModuleBase.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+namespace internal
+{
+
+/*!
+ * Base class of parameter snapshots - so that modules can swap them
+ */
+class tParameterSnapshotBase
+{
+public:
+
+  /*!
+   * Makes new value visible - if a new one was written
+   * (called by tModuleBase at cycle boundaries)
+   */
+  virtual void Swap() = 0;
+
+protected:
+
+  /*!
+   * \param module Module to register snapshot at
+   */
+  tParameterSnapshotBase(tModuleBase* module) : module(module)
+  {
+    module->parameter_snapshots.push_back(this);
+  }
+
+  ~tParameterSnapshotBase()
+  {
+    auto& snapshots = module->parameter_snapshots;
+    snapshots.erase(std::remove(snapshots.begin(), snapshots.end(), this), snapshots.end());
+  }
+
+  /*! \return Module that snapshot is a member of (found via its address) */
+  static tModuleBase* FindModule(void* address)
+  {
+    tModuleBase* module = dynamic_cast<tModuleBase*>(FindParent(address));
+    if (!module)
+    {
+      FINROC_LOG_PRINT_STATIC(ERROR, "Parameter snapshots must be members of modules. Aborting.");
+      abort();
+    }
+    return module;
+  }
+
+private:
+
+  /*! Module that snapshot is registered at */
+  tModuleBase* module;
+};
+
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Double-buffered value derived from parameters
+/*!
+ * Double-buffered value that is written in OnParametersChanged() and read in Update()/Sense()/Control().
+ *
+ * OnParametersChanged() writes to the back buffer (Set() or GetBackBuffer()).
+ * Before the next Update()/Sense()/Control() call (after OnParametersChanged() has completed),
+ * back and front buffer are swapped. Get() returns the front buffer without locking.
+ *
+ * References obtained with Get() must not be kept beyond the current Update()/Sense()/Control() call:
+ * after the next swap, the buffer is written by the next OnParametersChanged() call.
+ * With asynchronous parameter change processing (only available in tModule), this is safe,
+ * as swapping and Update() are done by the same thread - and OnParametersChanged()
+ * is only started after the swap.
+ * In a tSenseControlModule whose Sense() and Control() are executed by different threads,
+ * snapshots are not safer than other members written in OnParametersChanged().
+ *
+ * \tparam T Type of value (must be copy-assignable)
+ */
+template <typename T>
+class tParameterSnapshot : public internal::tParameterSnapshotBase
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Creates snapshot (only possible when plain member of module)
+   *
+   * \param initial_value Initial value
+   */
+  explicit tParameterSnapshot(const T& initial_value = T()) :
+    tParameterSnapshotBase(FindModule(this)),
+    buffers { initial_value, initial_value },
+    front(0),
+    back_written(false),
+    back_outdated(false)
+  {}
+
+  /*!
+   * \param module Module that snapshot belongs to
+   * \param initial_value Initial value
+   */
+  tParameterSnapshot(tModuleBase* module, const T& initial_value) :
+    tParameterSnapshotBase(module),
+    buffers { initial_value, initial_value },
+    front(0),
+    back_written(false),
+    back_outdated(false)
+  {}
+
+  tParameterSnapshot(const tParameterSnapshot&) = delete;
+  tParameterSnapshot& operator=(const tParameterSnapshot&) = delete;
+
+  /*!
+   * (to be called in Update()/Sense()/Control())
+   *
+   * \return Current value
+   */
+  const T& Get() const
+  {
+    return buffers[front.load(std::memory_order_acquire)];
+  }
+
+  /*!
+   * (to be called in OnParametersChanged())
+   *
+   * \return Reference to new value - initially a copy of the current value. Becomes visible in the next cycle.
+   */
+  T& GetBackBuffer()
+  {
+    unsigned int back = 1 - front.load(std::memory_order_relaxed);
+    if (back_outdated)
+    {
+      buffers[back] = buffers[1 - back];
+      back_outdated = false;
+    }
+    back_written = true;
+    return buffers[back];
+  }
+
+  /*!
+   * (to be called in OnParametersChanged())
+   *
+   * \param value New value. Becomes visible in the next cycle.
+   */
+  void Set(const T& value)
+  {
+    back_outdated = false;
+    back_written = true;
+    buffers[1 - front.load(std::memory_order_relaxed)] = value;
+  }
+
+  virtual void Swap() override
+  {
+    if (back_written)
+    {
+      front.store(1 - front.load(std::memory_order_relaxed), std::memory_order_release);
+      back_written = false;
+      back_outdated = true; // copying is done by the thread calling OnParametersChanged() - not at the cycle boundary
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Front and back buffer */
+  T buffers[2];
+
+  /*! Index of front buffer */
+  std::atomic<unsigned int> front;
+
+  /*! Was back buffer written since last swap? */
+  bool back_written;
+
+  /*! Does back buffer contain an outdated value (it is copied from front buffer on first access) */
+  bool back_outdated;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
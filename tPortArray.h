@@ -0,0 +1,409 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/tPortArray.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tPortArray and tDynamicPortArray
+ *
+ * \b tPortArray
+ *
+ * Array of convenience ports with a fixed number of elements.
+ * Can be used as a plain member of a component - like a single convenience port
+ * (e.g. tPortArray<tOutput<double>, 6> joint_positions;).
+ *
+ * \b tDynamicPortArray
+ *
+ * Array of convenience ports whose number of elements can be adjusted
+ * at application runtime (e.g. in OnStaticParameterChange()).
+ *
+ * Ports of both arrays are stored contiguously.
+ * If no name is provided, ports are named "<auto-generated name of array member> <index>".
+ * The array member consumes only one auto-generated port name.
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__structure__tPortArray_h__
+#define __plugins__structure__tPortArray_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/tConveniencePort.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace structure
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+namespace internal
+{
+
+/*! \return Name of port array element: <common_prefix><index><common_postfix> */
+inline std::string GetPortArrayElementName(const std::string& common_prefix, size_t index, const std::string& common_postfix)
+{
+  return common_prefix + std::to_string(index) + common_postfix;
+}
+
+/*! Bulk operations on contiguous ports */
+template <typename TPort, typename TValues>
+void PublishPorts(TPort* ports, size_t port_count, const TValues& values)
+{
+  size_t i = 0;
+  for (auto it = std::begin(values); it != std::end(values) && i < port_count; ++it, ++i)
+  {
+    ports[i].Publish(*it);
+  }
+}
+
+template <typename TPort, typename TValues>
+void GetPorts(TPort* ports, size_t port_count, TValues& values)
+{
+  size_t i = 0;
+  for (auto it = std::begin(values); it != std::end(values) && i < port_count; ++it, ++i)
+  {
+    *it = ports[i].Get();
+  }
+}
+
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Port array with fixed size
+/*!
+ * Array of convenience ports with a fixed number of elements.
+ * Ports are stored contiguously inside the array object (and therefore inside the component).
+ *
+ * \tparam TPort Convenience port type of elements (e.g. tModule::tOutput<double>)
+ * \tparam Tsize Number of ports in array
+ */
+template <typename TPort, size_t Tsize>
+class tPortArray
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef TPort* iterator;
+  typedef const TPort* const_iterator;
+
+  /*!
+   * Creates ports with auto-generated names (only possible when array is plain member of component).
+   * Ports are named "<auto-generated name of array member> <start_index>", "<auto-generated name of array member> <start_index + 1>", ...
+   *
+   * \param start_index Number in name of first port in array
+   */
+  explicit tPortArray(size_t start_index = 1)
+  {
+    auto parent = TPort::FindParent(this);
+    CreatePorts(TPort::GetPortName(parent) + " ", parent, start_index, "");
+  }
+
+  /*!
+   * Ports are named: <common_prefix><start_index><common_postfix>, <common_prefix><start_index + 1><common_postfix>, ...
+   *
+   * \param common_prefix Common prefix of all ports names (add a pending space if you like to have a space between prefix and index)
+   * \param parent Component that ports belong to
+   * \param start_index Number in name of first port in array
+   * \param common_postfix Common postfix of all ports names
+   */
+  tPortArray(const std::string& common_prefix, core::tFrameworkElement* parent, size_t start_index = 1, const std::string& common_postfix = "")
+  {
+    CreatePorts(common_prefix, parent, start_index, common_postfix);
+  }
+
+  tPortArray(const tPortArray&) = delete;
+  tPortArray& operator=(const tPortArray&) = delete;
+
+  ~tPortArray()
+  {
+    // Only wrappers are destructed - ports are deleted with their component
+    for (TPort & port : *this)
+    {
+      port.~TPort();
+    }
+  }
+
+  TPort& operator[](size_t index)
+  {
+    return begin()[index];
+  }
+  const TPort& operator[](size_t index) const
+  {
+    return begin()[index];
+  }
+
+  iterator begin()
+  {
+    return reinterpret_cast<TPort*>(&ports[0]);
+  }
+  const_iterator begin() const
+  {
+    return reinterpret_cast<const TPort*>(&ports[0]);
+  }
+  iterator end()
+  {
+    return begin() + Tsize;
+  }
+  const_iterator end() const
+  {
+    return begin() + Tsize;
+  }
+
+  /*!
+   * Retrieves current values of all (input) ports
+   *
+   * \param values Container to write values to (e.g. std::array or std::vector; surplus elements are not modified)
+   */
+  template <typename TValues>
+  void Get(TValues& values)
+  {
+    internal::GetPorts(begin(), Tsize, values);
+  }
+
+  /*!
+   * Publishes values via all (output) ports
+   *
+   * \param values Values to publish (element i is published via port i; surplus values are ignored)
+   */
+  template <typename TValues>
+  void Publish(const TValues& values)
+  {
+    internal::PublishPorts(begin(), Tsize, values);
+  }
+
+  /*!
+   * \return Number of ports in array
+   */
+  static constexpr size_t size()
+  {
+    return Tsize;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Storage for ports (ports are constructed in constructor) */
+  typename std::aligned_storage<sizeof(TPort), alignof(TPort)>::type ports[Tsize];
+
+  void CreatePorts(const std::string& common_prefix, core::tFrameworkElement* parent, size_t start_index, const std::string& common_postfix)
+  {
+    for (size_t i = 0; i < Tsize; i++)
+    {
+      new(&ports[i]) TPort(internal::tPortArrayElement { internal::GetPortArrayElementName(common_prefix, start_index + i, common_postfix), parent });
+    }
+  }
+};
+
+//! Port array with adjustable size
+/*!
+ * Array of convenience ports whose number of elements can be adjusted.
+ * Port wrappers are stored contiguously.
+ *
+ * \tparam TPort Convenience port type of elements (e.g. tModule::tOutput<double>)
+ */
+template <typename TPort>
+class tDynamicPortArray
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename std::vector<TPort>::iterator iterator;
+  typedef typename std::vector<TPort>::const_iterator const_iterator;
+
+  /*!
+   * Creates ports with auto-generated names (only possible when array is plain member of component).
+   * Ports are named "<auto-generated name of array member> <start_index>", "<auto-generated name of array member> <start_index + 1>", ...
+   *
+   * \param size Initial number of ports
+   * \param start_index Number in name of first port in array
+   */
+  explicit tDynamicPortArray(size_t size = 0, size_t start_index = 1) :
+    parent(NULL),
+    common_prefix(),
+    common_postfix(),
+    start_index(start_index),
+    ports()
+  {
+    auto component = TPort::FindParent(this);
+    parent = component;
+    common_prefix = TPort::GetPortName(component) + " ";
+    Resize(size);
+  }
+
+  /*!
+   * Ports are named: <common_prefix><start_index><common_postfix>, <common_prefix><start_index + 1><common_postfix>, ...
+   *
+   * \param common_prefix Common prefix of all ports names (add a pending space if you like to have a space between prefix and index)
+   * \param parent Component that ports belong to
+   * \param size Initial number of ports
+   * \param start_index Number in name of first port in array
+   * \param common_postfix Common postfix of all ports names
+   */
+  tDynamicPortArray(const std::string& common_prefix, core::tFrameworkElement* parent, size_t size = 0, size_t start_index = 1, const std::string& common_postfix = "") :
+    parent(parent),
+    common_prefix(common_prefix),
+    common_postfix(common_postfix),
+    start_index(start_index),
+    ports()
+  {
+    Resize(size);
+  }
+
+  tDynamicPortArray(const tDynamicPortArray&) = delete;
+  tDynamicPortArray& operator=(const tDynamicPortArray&) = delete;
+
+  TPort& operator[](size_t index)
+  {
+    return ports[index];
+  }
+  const TPort& operator[](size_t index) const
+  {
+    return ports[index];
+  }
+
+  iterator begin()
+  {
+    return ports.begin();
+  }
+  const_iterator begin() const
+  {
+    return ports.begin();
+  }
+  iterator end()
+  {
+    return ports.end();
+  }
+  const_iterator end() const
+  {
+    return ports.end();
+  }
+
+  /*!
+   * Retrieves current values of all (input) ports
+   *
+   * \param values Container to write values to (e.g. std::array or std::vector; surplus elements are not modified)
+   */
+  template <typename TValues>
+  void Get(TValues& values)
+  {
+    internal::GetPorts(ports.data(), ports.size(), values);
+  }
+
+  /*!
+   * Publishes values via all (output) ports
+   *
+   * \param values Values to publish (element i is published via port i; surplus values are ignored)
+   */
+  template <typename TValues>
+  void Publish(const TValues& values)
+  {
+    internal::PublishPorts(ports.data(), ports.size(), values);
+  }
+
+  /*!
+   * Adjusts number of ports in array.
+   * Ports at the back are deleted or appended.
+   * If component is already initialized, all appended ports are initialized together.
+   *
+   * \param size Number of ports the array should have
+   */
+  void Resize(size_t size)
+  {
+    if (size == ports.size())
+    {
+      return;
+    }
+
+    rrlib::thread::tLock lock(parent->GetStructureMutex());
+    while (ports.size() > size)
+    {
+      ports.back().GetWrapped()->ManagedDelete();
+      ports.pop_back();
+    }
+    size_t old_size = ports.size();
+    ports.reserve(size);
+    while (ports.size() < size)
+    {
+      ports.emplace_back(internal::tPortArrayElement { internal::GetPortArrayElementName(common_prefix, start_index + ports.size(), common_postfix), parent });
+    }
+    if (ports.size() > old_size && parent->IsReady())
+    {
+      ports[old_size].GetWrapped()->GetParent()->Init();
+    }
+  }
+
+  /*!
+   * \return Number of ports in array
+   */
+  size_t size() const
+  {
+    return ports.size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Component that ports belong to */
+  core::tFrameworkElement* parent;
+
+  /*! Port naming (see constructor) */
+  std::string common_prefix, common_postfix;
+  size_t start_index;
+
+  /*! Ports in array */
+  std::vector<TPort> ports;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -39,6 +39,8 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/structure/internal/tTaskProfiler.h"
+#include "plugins/structure/internal/tracing.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -78,6 +80,8 @@ tSenseControlModule::tSenseControlModule(tFrameworkElement *parent, const std::s
     share_so_and_ci_ports(share_so_and_ci_ports),
     sense_task(*this),
     control_task(*this),
+    sense_profiler(),
+    control_profiler(),
     sensor_input_changed(true),
     controller_input_changed(true)
 {
@@ -88,6 +92,18 @@ tSenseControlModule::tSenseControlModule(tFrameworkElement *parent, const std::s
 tSenseControlModule::~tSenseControlModule()
 {}
 
+const std::vector<data_ports::common::tAbstractDataPort*>& tSenseControlModule::ChangedSensorInputs()
+{
+  static const std::vector<data_ports::common::tAbstractDataPort*> cNO_PORTS;
+  return sensor_input ? GetChangedPorts(*sensor_input) : cNO_PORTS;
+}
+
+const std::vector<data_ports::common::tAbstractDataPort*>& tSenseControlModule::ChangedControllerInputs()
+{
+  static const std::vector<data_ports::common::tAbstractDataPort*> cNO_PORTS;
+  return controller_input ? GetChangedPorts(*controller_input) : cNO_PORTS;
+}
+
 void tSenseControlModule::PostChildInit()
 {
   CheckStaticParameters(); // evaluate static parameters before we create the tasks
@@ -99,7 +115,9 @@ void tSenseControlModule::PostChildInit()
     {
       execution_duration = data_ports::tOutputPort<rrlib::time::tDuration>(&GetProfilingPortGroup(), "Control() Duration");
       execution_duration.Init();
+      control_profiler.reset(new internal::tTaskProfiler(GetProfilingPortGroup(), "Control()"));
     }
+    this->control_task.traced_task = internal::RegisterTracedTask(GetQualifiedName() + " Control()", *this);
     controller_task_parent->AddAnnotation(*new scheduling::tPeriodicFrameworkElementTask(this->controller_input, this->controller_output, this->control_task, execution_duration));
   }
   else
@@ -115,20 +133,47 @@ void tSenseControlModule::PostChildInit()
     {
       execution_duration = data_ports::tOutputPort<rrlib::time::tDuration>(&GetProfilingPortGroup(), "Sense() Duration");
       execution_duration.Init();
+      sense_profiler.reset(new internal::tTaskProfiler(GetProfilingPortGroup(), "Sense()"));
     }
+    this->sense_task.traced_task = internal::RegisterTracedTask(GetQualifiedName() + " Sense()", *this);
     sensor_task_parent->AddAnnotation(*new scheduling::tPeriodicFrameworkElementTask(this->sensor_input, this->sensor_output, this->sense_task, execution_duration));
   }
   else
   {
     FINROC_LOG_PRINT(WARNING, "Module has no sensor interfaces. Sense() will not be called!");
   }
+
+  if (this->controller_input)
+  {
+    PrepareChangedFlagProcessing(*this->controller_input);
+  }
+  if (this->sensor_input)
+  {
+    PrepareChangedFlagProcessing(*this->sensor_input);
+  }
+  tModuleBase::PostChildInit();
+}
+
+void tSenseControlModule::PrepareDelete()
+{
+  // statistics must not be published while profiling ports are deleted
+  if (sense_profiler)
+  {
+    sense_profiler->WaitForPublication();
+  }
+  if (control_profiler)
+  {
+    control_profiler->WaitForPublication();
+  }
+  tModuleBase::PrepareDelete();
 }
 
 //----------------------------------------------------------------------
 // tSenseControlModule::ControlTask constructors
 //----------------------------------------------------------------------
 tSenseControlModule::ControlTask::ControlTask(tSenseControlModule& module)
-  : module(module)
+  : module(module),
+    traced_task({ 0, nullptr })
 {}
 
 //----------------------------------------------------------------------
@@ -136,11 +181,19 @@ tSenseControlModule::ControlTask::ControlTask(tSenseControlModule& module)
 //----------------------------------------------------------------------
 void tSenseControlModule::ControlTask::ExecuteTask()
 {
+  internal::tTraceScope trace(this->traced_task);
+  if (!this->module.IsExecutionCycle(tCycleFunction::CONTROL))
+  {
+    return;
+  }
+  internal::tTaskProfiler::tScope profile(this->module.control_profiler.get());
   this->module.CheckParameters();
   if (this->module.controller_input)
   {
     this->module.controller_input_changed = this->module.ProcessChangedFlags(*this->module.controller_input);
   }
+  tBudgetScope budget(this->module, tCycleFunction::CONTROL);
+  internal::tTaskProfiler::tAllocationScope allocations(this->module.control_profiler.get());
   this->module.Control();
 }
 
@@ -148,7 +201,8 @@ void tSenseControlModule::ControlTask::ExecuteTask()
 // tSenseControlModule::SenseTask constructors
 //----------------------------------------------------------------------
 tSenseControlModule::SenseTask::SenseTask(tSenseControlModule& module)
-  : module(module)
+  : module(module),
+    traced_task({ 0, nullptr })
 {}
 
 //----------------------------------------------------------------------
@@ -156,11 +210,19 @@ tSenseControlModule::SenseTask::SenseTask(tSenseControlModule& module)
 //----------------------------------------------------------------------
 void tSenseControlModule::SenseTask::ExecuteTask()
 {
+  internal::tTraceScope trace(this->traced_task);
+  if (!this->module.IsExecutionCycle(tCycleFunction::SENSE))
+  {
+    return;
+  }
+  internal::tTaskProfiler::tScope profile(this->module.sense_profiler.get());
   this->module.CheckParameters();
   if (this->module.sensor_input)
   {
     this->module.sensor_input_changed = this->module.ProcessChangedFlags(*this->module.sensor_input);
   }
+  tBudgetScope budget(this->module, tCycleFunction::SENSE);
+  internal::tTaskProfiler::tAllocationScope allocations(this->module.sense_profiler.get());
   this->module.Sense();
 }
 
@@ -49,6 +49,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/structure/tModuleBase.h"
+#include "plugins/structure/internal/tracing.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -199,13 +200,48 @@ protected:
     return controller_input_changed;
   }
 
+  /*!
+   * May be called in Sense() or Control() method to obtain the sensor or controller input ports
+   * that have changed since last call to Sense() or Control() respectively.
+   *
+   * \return Changed sensor or controller input ports
+   */
+  const std::vector<data_ports::common::tAbstractDataPort*>& ChangedSensorInputs();
+  const std::vector<data_ports::common::tAbstractDataPort*>& ChangedControllerInputs();
+
+  /*!
+   * Change sequence numbers of module's sensor and controller inputs:
+   * incremented in every cycle in which any port of the respective interface changed.
+   * Together with GetChangeSequence(port), this can be used to determine which inputs
+   * changed since some earlier cycle.
+   *
+   * \return Change sequence number of module's sensor or controller inputs
+   */
+  uint64_t SensorInputChangeSequence()
+  {
+    return sensor_input ? GetChangeSequence(*sensor_input) : 0;
+  }
+  uint64_t ControllerInputChangeSequence()
+  {
+    return controller_input ? GetChangeSequence(*controller_input) : 0;
+  }
+
   virtual void PostChildInit() override;
 
+  virtual void PrepareDelete() override;
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  /*!
+   * Asynchronous parameter change processing is not available:
+   * Sense() and Control() may be executed by different threads. A background OnParametersChanged() call
+   * started after one task swapped in new parameter snapshots would write to buffers the other task might still be reading.
+   */
+  using tModuleBase::SetAsynchronousParameterChangeProcessing;
+
   /*! Module's interfaces */
   core::tPortGroup *sensor_input;
   core::tPortGroup *sensor_output;
@@ -222,6 +258,9 @@ private:
   public:
     ControlTask(tSenseControlModule& module);
     virtual void ExecuteTask() override;
+
+    /*! Task in trace (with zero id if not traced) */
+    internal::tTracedTask traced_task;
   };
 
   /*! Task that calls Sense() regularly */
@@ -231,11 +270,17 @@ private:
   public:
     SenseTask(tSenseControlModule& module);
     virtual void ExecuteTask() override;
+
+    /*! Task in trace (with zero id if not traced) */
+    internal::tTracedTask traced_task;
   };
 
   SenseTask sense_task;
   ControlTask control_task;
 
+  /*! Profile Sense() and Control() calls (only created if profiling is enabled) */
+  std::unique_ptr<internal::tTaskProfiler> sense_profiler, control_profiler;
+
   /*! Has any sensor input port changed since last cycle? */
   bool sensor_input_changed;
 
@@ -0,0 +1,185 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/structure/tests/test_update_triggers.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests skipping of Update() calls in modules with update triggers:
+ * Changes of non-trigger inputs in skipped cycles must be reported in the next Update() call.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "rrlib/util/tUnitTestSuite.h"
+#include "core/tRuntimeEnvironment.h"
+#include "plugins/data_ports/tOutputPort.h"
+#include "plugins/scheduling/tPeriodicFrameworkElementTask.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/structure/tModule.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Module with one trigger input and one non-trigger input.
+ * Records what Update() observes.
+ */
+class mTriggeredModule : public structure::tModule
+{
+public:
+
+  tInput<int> trigger, other;
+
+  /*! Number of Update() calls */
+  int update_count;
+
+  /*! Values observed in last Update() call */
+  bool input_changed, trigger_changed, other_changed;
+  size_t changed_input_count;
+
+  mTriggeredModule(core::tFrameworkElement* parent, const std::string& name) :
+    tModule(parent, name),
+    trigger("Trigger", this),
+    other("Other", this),
+    update_count(0),
+    input_changed(false),
+    trigger_changed(false),
+    other_changed(false),
+    changed_input_count(0)
+  {
+    AddUpdateTrigger(trigger);
+  }
+
+  /*! Executes module's update task once (as its thread container would) */
+  void ExecuteCycle()
+  {
+    GetAnnotation<scheduling::tPeriodicFrameworkElementTask>()->task.ExecuteTask();
+  }
+
+  /*! \return Was specified port reported by ChangedInputs() in last Update() call? */
+  bool ReportedAsChanged(const core::tPortWrapperBase& port)
+  {
+    return std::find(changed_inputs.begin(), changed_inputs.end(), port.GetWrapped()) != changed_inputs.end();
+  }
+
+private:
+
+  std::vector<data_ports::common::tAbstractDataPort*> changed_inputs;
+
+  virtual void Update() override
+  {
+    update_count++;
+    input_changed = InputChanged();
+    trigger_changed = trigger.HasChanged();
+    other_changed = other.HasChanged();
+    changed_inputs = ChangedInputs();
+    changed_input_count = changed_inputs.size();
+  }
+};
+
+class TestUpdateTriggers : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TestUpdateTriggers);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChangesInSkippedCycles);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestChangesInSkippedCycles()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(&core::tRuntimeEnvironment::GetInstance(), "TestUpdateTriggers");
+    mTriggeredModule* module = new mTriggeredModule(parent, "Module");
+    data_ports::tOutputPort<int> trigger_source(parent, "Trigger Source");
+    data_ports::tOutputPort<int> other_source(parent, "Other Source");
+    trigger_source.ConnectTo(module->trigger);
+    other_source.ConnectTo(module->other);
+    parent->Init();
+
+    // First cycle is never skipped
+    module->ExecuteCycle();
+    RRLIB_UNIT_TESTS_EQUALITY(1, module->update_count);
+
+    // Non-trigger input changes: Update() is skipped
+    other_source.Publish(1);
+    module->ExecuteCycle();
+    RRLIB_UNIT_TESTS_EQUALITY(1, module->update_count);
+
+    // Nothing changes: Update() is skipped
+    module->ExecuteCycle();
+    RRLIB_UNIT_TESTS_EQUALITY(1, module->update_count);
+
+    // Trigger changes: Update() observes both changes
+    trigger_source.Publish(2);
+    module->ExecuteCycle();
+    RRLIB_UNIT_TESTS_EQUALITY(2, module->update_count);
+    RRLIB_UNIT_TESTS_ASSERT(module->input_changed);
+    RRLIB_UNIT_TESTS_ASSERT(module->trigger_changed);
+    RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Change of non-trigger input in skipped cycle was lost", module->other_changed);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), module->changed_input_count);
+    RRLIB_UNIT_TESTS_ASSERT(module->ReportedAsChanged(module->trigger) && module->ReportedAsChanged(module->other));
+
+    // Non-trigger input changes in the same cycle as trigger: reported once
+    other_source.Publish(3);
+    trigger_source.Publish(4);
+    module->ExecuteCycle();
+    RRLIB_UNIT_TESTS_EQUALITY(3, module->update_count);
+    RRLIB_UNIT_TESTS_ASSERT(module->trigger_changed && module->other_changed);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), module->changed_input_count);
+
+    // Changes are reset after Update() was called with them
+    trigger_source.Publish(5);
+    module->ExecuteCycle();
+    RRLIB_UNIT_TESTS_EQUALITY(4, module->update_count);
+    RRLIB_UNIT_TESTS_ASSERT(module->trigger_changed);
+    RRLIB_UNIT_TESTS_ASSERT(!module->other_changed);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), module->changed_input_count);
+
+    parent->ManagedDelete();
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TestUpdateTriggers);